@@ -0,0 +1,72 @@
+#include "brain.hpp"
+#include "kernel.hpp"
+#include "robot_config.hpp"
+#include <algorithm>
+#include <initializer_list>
+
+// How long the IMU takes to calibrate after reset()
+#define IMU_CALIBRATION_TIME 1800
+
+namespace host {
+
+static constexpr int portNumber(int port) { return port < 0 ? -port : port; }
+
+static constexpr Brain wiredBrain() {
+    Brain wired;
+    auto plug = [&](int port, pros::c::v5_device_e_t type) { wired.ports[portNumber(port) - 1].type = type; };
+    for (int port : {PORT_LEFT_MOTOR_1, PORT_LEFT_MOTOR_2, PORT_LEFT_MOTOR_3, PORT_RIGHT_MOTOR_1, PORT_RIGHT_MOTOR_2,
+                     PORT_RIGHT_MOTOR_3}) {
+        plug(port, pros::c::E_DEVICE_MOTOR);
+    }
+    plug(PORT_IMU, pros::c::E_DEVICE_IMU);
+    plug(PORT_HORIZONTAL_ENCODER, pros::c::E_DEVICE_ROTATION);
+    plug(PORT_VERTICAL_ENCODER, pros::c::E_DEVICE_ROTATION);
+    for (int port : {PORT_DISTANCE_RIGHT, PORT_DISTANCE_LEFT, PORT_DISTANCE_FRONT, PORT_DISTANCE_BACK}) {
+        plug(port, pros::c::E_DEVICE_DISTANCE);
+    }
+    return wired;
+}
+
+constinit Brain brain = wiredBrain();
+
+double MotorPort::maxRpm() const {
+    switch (gearset) {
+        case pros::E_MOTOR_GEAR_RED: return 100;
+        case pros::E_MOTOR_GEAR_BLUE: return 600;
+        default: return 200;
+    }
+}
+
+int32_t MotorPort::commandedVoltage() const {
+    if (mode != MotorMode::VOLTAGE) return 0;
+    int32_t limit = voltageLimit > 0 ? std::min(voltageLimit, 12000) : 12000;
+    return std::clamp(targetVoltage, -limit, limit);
+}
+
+bool MotorPort::stopping() const {
+    return mode == MotorMode::BRAKE || (mode == MotorMode::VOLTAGE && targetVoltage == 0) ||
+           (mode == MotorMode::VELOCITY && targetVelocity == 0);
+}
+
+bool ImuPort::calibrating() const { return static_cast<int32_t>(nowMs() - calibrationEnd) < 0; }
+
+void ImuPort::turn(double degrees) {
+    if (!calibrating()) rotation += degrees;
+}
+
+void ImuPort::startCalibration() {
+    calibrationEnd = nowMs() + IMU_CALIBRATION_TIME;
+    rotation = 0;
+    rotationOffset = headingOffset = pitchOffset = rollOffset = yawOffset = 0;
+}
+
+SmartPort* Brain::port(int number) {
+    number = portNumber(number);
+    return number >= 1 && number <= 21 ? &ports[number - 1] : nullptr;
+}
+
+void Brain::plug(int number, pros::c::v5_device_e_t type) {
+    if (SmartPort* slot = port(number)) slot->type = type;
+}
+
+} // namespace host
@@ -0,0 +1,118 @@
+#ifndef HOST_BRAIN_HPP
+#define HOST_BRAIN_HPP
+
+#include "pros/apix.h"
+#include <cstdint>
+
+// --- Host Brain ---
+// The state behind every smart port, ADI port and the controller of the simulated brain. The stand-in PROS classes
+// (pros_devices.cpp, pros_misc.cpp) read and command these exactly like the real devices; a world model
+// (world.hpp) writes the measurements once per tick and reads the motor commands back.
+// Sensor values are stored raw, in the device's own direction: reversal and zero offsets are applied by the
+// device, as on the brain.
+
+namespace host {
+
+enum class MotorMode { VOLTAGE, VELOCITY, POSITION, BRAKE };
+
+struct MotorPort {
+    // Command, in the motor's own direction (MotorGroup applies reversed ports)
+    MotorMode mode = MotorMode::VOLTAGE;
+    int32_t targetVoltage = 0;   // mV
+    int32_t targetVelocity = 0;  // rpm, for VELOCITY and POSITION
+    double targetPosition = 0;   // Degrees, raw
+    pros::motor_brake_mode_e_t brakeMode = pros::E_MOTOR_BRAKE_COAST;
+    pros::motor_gearset_e_t gearset = pros::E_MOTOR_GEAR_GREEN;
+    pros::motor_encoder_units_e_t units = pros::E_MOTOR_ENCODER_DEGREES;
+    int32_t currentLimit = 2500; // mA
+    int32_t voltageLimit = 0;    // mV, 0 for none
+    // Measured, written by the world
+    double position = 0;         // Degrees of the cartridge output shaft since power-on
+    double zero = 0;             // Raw position that reads as zero
+    double velocity = 0;         // rpm
+    int32_t voltage = 0;         // mV actually applied
+    int32_t current = 0;         // mA
+    double torque = 0;           // Nm
+    double temperature = 25;     // Celsius
+
+    // Free speed of the cartridge
+    double maxRpm() const;
+    // Voltage the motor is being asked for, with the voltage limit applied; brake and hold read as 0
+    int32_t commandedVoltage() const;
+    // True when the motor should stop according to its brake mode (a zero voltage command or brake())
+    bool stopping() const;
+};
+
+struct RotationPort {
+    double angle = 0;      // Degrees turned since power-on, unbounded, written by the world
+    double velocity = 0;   // Degrees per second
+    double zero = 0;       // Raw angle that reads as position 0
+    bool reversed = false;
+};
+
+struct ImuPort {
+    double rotation = 0;   // Degrees clockwise since the last calibration, unbounded
+    double pitch = 0;
+    double roll = 0;
+    double gyroZ = 0;      // Degrees per second, clockwise positive
+    double accelX = 0;     // g
+    double accelY = 0;
+    double accelZ = 1;
+    double rotationOffset = 0, headingOffset = 0, pitchOffset = 0, rollOffset = 0, yawOffset = 0;
+    uint32_t calibrationEnd = 0; // The IMU reads nothing until this time (ms)
+
+    bool calibrating() const;
+    // Adds a turn measured by the world; ignored while calibrating, like the real sensor
+    void turn(double degrees);
+    void startCalibration();
+};
+
+struct DistancePort {
+    int32_t distance = 9999;  // mm; 9999 when nothing is in range
+    int32_t confidence = 0;   // 0-63
+    int32_t objectSize = 0;   // 0-400
+    double objectVelocity = 0; // m/s
+};
+
+struct SmartPort {
+    pros::c::v5_device_e_t type = pros::c::E_DEVICE_NONE;
+    MotorPort motor;
+    RotationPort rotation;
+    ImuPort imu;
+    DistancePort distance;
+};
+
+struct ControllerState {
+    bool connected = true;
+    int32_t analog[4] = {};              // Indexed by controller_analog_e_t
+    bool digital[13] = {};               // Indexed by controller_digital_e_t - E_CONTROLLER_DIGITAL_L1
+    bool pressReported[13] = {};         // get_digital_new_press() already returned true for the current press
+    bool releaseReported[13] = {};
+    char text[3][20] = {};               // Lines as last written
+    uint32_t lastText = 0;               // The controller takes one screen write per 50 ms
+    bool textWritten = false;
+};
+
+struct Brain {
+    SmartPort ports[21];                 // Index = port - 1
+    int32_t adi[8] = {};                 // Raw ADI values, index = port - 1
+    ControllerState controller;
+    double batteryCapacity = 100;        // Percent
+    int32_t batteryVoltage = 12800;      // mV
+    int32_t batteryCurrent = 0;          // mA
+    double batteryTemperature = 25;
+    uint8_t competition = COMPETITION_DISABLED | COMPETITION_CONNECTED;
+
+    // Port by its 1-based number (sign ignored); nullptr when out of range
+    SmartPort* port(int number);
+    // Plugs a device into a port (sign ignored), so get_plugged_type() and the device classes find it
+    void plug(int number, pros::c::v5_device_e_t type);
+};
+
+// Constant-initialized with the robot's devices already plugged in (robot_config.hpp), so the device constructors in
+// main.cpp find them during static initialization, as they would at power-on
+extern Brain brain;
+
+} // namespace host
+
+#endif
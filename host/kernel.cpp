@@ -0,0 +1,547 @@
+#include "kernel.hpp"
+#include "pros/rtos.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <vector>
+
+// Host stack per task. Much larger than the brain's (x86-64 frames and unoptimized fmt calls are bigger), with a
+// guard page below it so an overflow faults instead of corrupting the next task.
+#define HOST_STACK_SIZE (512 * 1024)
+
+using pros::mutex_t;
+using pros::task_fn_t;
+using pros::task_t;
+
+namespace {
+
+enum class Wait { NONE, DELAY, NOTIFY, MUTEX, JOIN };
+
+struct HostMutex;
+
+struct Tcb {
+    ucontext_t context;
+    void* stackMapping = nullptr;
+    size_t mappingSize = 0;
+    task_fn_t function;
+    void* parameters;
+    uint32_t priority;
+    char name[TASK_NAME_MAX_LEN];
+    pros::task_state_e_t state = pros::E_TASK_STATE_READY;
+    uint64_t readySeq = 0; // FIFO order among equal priorities
+    // Blocking
+    Wait wait = Wait::NONE;
+    bool timed = false;
+    uint32_t wakeMs = 0;
+    bool timedOut = false;
+    HostMutex* waitingOn = nullptr;
+    Tcb* joining = nullptr;
+    // Direct-to-task notification
+    uint32_t notifyValue = 0;
+    bool notifyPending = false;
+};
+
+struct HostMutex {
+    Tcb* owner = nullptr;
+    bool taken = false;
+    uint32_t count = 0; // Recursive takes
+    bool recursive = false;
+};
+
+std::vector<Tcb*> tasks; // Every task ever created; handles stay valid after deletion
+Tcb* current = nullptr;
+ucontext_t schedulerContext;
+uint64_t clockUs = 0;
+uint64_t readySeq = 0;
+host::TickHook tickHook;
+bool stopRequested = false;
+int stopCode = 0;
+
+bool alive(const Tcb* task) { return task->state != pros::E_TASK_STATE_DELETED; }
+
+void makeReady(Tcb* task) {
+    task->state = pros::E_TASK_STATE_READY;
+    task->wait = Wait::NONE;
+    task->timed = false;
+    task->waitingOn = nullptr;
+    task->joining = nullptr;
+    task->readySeq = ++readySeq;
+}
+
+// Highest priority, then longest ready
+Tcb* pickReady() {
+    Tcb* best = nullptr;
+    for (Tcb* task : tasks) {
+        if (task->state != pros::E_TASK_STATE_READY) continue;
+        if (best == nullptr || task->priority > best->priority ||
+            (task->priority == best->priority && task->readySeq < best->readySeq)) {
+            best = task;
+        }
+    }
+    return best;
+}
+
+bool readyAbove(uint32_t priority, bool orEqual) {
+    for (Tcb* task : tasks) {
+        if (task->state != pros::E_TASK_STATE_READY) continue;
+        if (task->priority > priority || (orEqual && task->priority == priority)) return true;
+    }
+    return false;
+}
+
+void switchToScheduler() { swapcontext(&current->context, &schedulerContext); }
+
+void yieldCurrent() {
+    makeReady(current);
+    switchToScheduler();
+}
+
+// Gives the CPU to a task that was just made ready, if it outranks the caller
+void preemptIfNeeded() {
+    if (current != nullptr && readyAbove(current->priority, false)) yieldCurrent();
+}
+
+// Blocks the current task until woken or, when `timeout` isn't TIMEOUT_MAX, until `timeout` ms from now.
+// Returns false on timeout.
+bool blockCurrent(Wait wait, uint32_t timeout) {
+    current->state = pros::E_TASK_STATE_BLOCKED;
+    current->wait = wait;
+    current->timed = timeout != TIMEOUT_MAX;
+    current->wakeMs = host::nowMs() + timeout;
+    current->timedOut = false;
+    switchToScheduler();
+    return !current->timedOut;
+}
+
+void releaseStack(Tcb* task) {
+    if (task->stackMapping == nullptr) return;
+    munmap(task->stackMapping, task->mappingSize);
+    task->stackMapping = nullptr;
+}
+
+void wakeJoiners(Tcb* finished) {
+    for (Tcb* task : tasks) {
+        if (task->state == pros::E_TASK_STATE_BLOCKED && task->wait == Wait::JOIN && task->joining == finished) {
+            makeReady(task);
+        }
+    }
+}
+
+void deleteTask(Tcb* task) {
+    if (!alive(task)) return;
+    task->state = pros::E_TASK_STATE_DELETED;
+    task->wait = Wait::NONE;
+    wakeJoiners(task);
+    // The running task's stack is freed by the scheduler once it has switched away from it
+    if (task != current) releaseStack(task);
+}
+
+void taskEntry() {
+    current->function(current->parameters);
+    deleteTask(current);
+    switchToScheduler(); // Never resumes
+}
+
+// One tick: the world moves, then every sleeper whose time has come wakes
+void runTick() {
+    uint32_t now = host::nowMs();
+    if (tickHook) tickHook(now);
+    for (Tcb* task : tasks) {
+        if (task->state == pros::E_TASK_STATE_BLOCKED && task->timed && static_cast<int32_t>(now - task->wakeMs) >= 0) {
+            makeReady(task);
+            task->timedOut = true;
+        }
+    }
+}
+
+// A busy-waiting task only sees time pass through its own clock reads
+void chargeClockRead() {
+    if (current == nullptr) return;
+    uint64_t before = clockUs;
+    clockUs += host::CLOCK_READ_COST_US;
+    if (clockUs / 1000 == before / 1000) return;
+    runTick();
+    // FreeRTOS time-slices equal priorities at every tick
+    if (readyAbove(current->priority, true)) yieldCurrent();
+}
+
+HostMutex* toMutex(mutex_t mutex) { return static_cast<HostMutex*>(mutex); }
+
+bool takeMutex(HostMutex* mutex, uint32_t timeout) {
+    if (mutex == nullptr) return false;
+    if (!mutex->taken) {
+        mutex->taken = true;
+        mutex->owner = current;
+        mutex->count = 1;
+        return true;
+    }
+    if (mutex->recursive && mutex->owner == current) {
+        mutex->count++;
+        return true;
+    }
+    if (timeout == 0 || current == nullptr) return false;
+    current->waitingOn = mutex;
+    // Ownership is handed over by giveMutex() before the waiter wakes
+    return blockCurrent(Wait::MUTEX, timeout);
+}
+
+bool giveMutex(HostMutex* mutex) {
+    if (mutex == nullptr || !mutex->taken || mutex->owner != current) return false;
+    if (--mutex->count > 0) return true;
+    Tcb* next = nullptr;
+    for (Tcb* task : tasks) {
+        if (task->state != pros::E_TASK_STATE_BLOCKED || task->wait != Wait::MUTEX || task->waitingOn != mutex) continue;
+        if (next == nullptr || task->priority > next->priority ||
+            (task->priority == next->priority && task->readySeq < next->readySeq)) {
+            next = task;
+        }
+    }
+    if (next == nullptr) {
+        mutex->taken = false;
+        mutex->owner = nullptr;
+        return true;
+    }
+    mutex->owner = next;
+    mutex->count = 1;
+    makeReady(next);
+    preemptIfNeeded();
+    return true;
+}
+
+Tcb* toTask(task_t task) { return task == nullptr ? current : static_cast<Tcb*>(task); }
+
+} // namespace
+
+// --- Host API ---
+namespace host {
+
+void setTickHook(TickHook hook) { tickHook = std::move(hook); }
+
+uint64_t nowUs() { return clockUs; }
+
+uint32_t nowMs() { return static_cast<uint32_t>(clockUs / 1000); }
+
+int run(uint32_t until) {
+    stopRequested = false;
+    while (!stopRequested) {
+        // Checked every switch, since a busy-waiting task keeps something ready at all times
+        if (nowMs() >= until) return -1;
+        Tcb* next = pickReady();
+        if (next == nullptr) {
+            clockUs = (clockUs / 1000 + 1) * 1000;
+            runTick();
+            continue;
+        }
+        next->state = pros::E_TASK_STATE_RUNNING;
+        current = next;
+        swapcontext(&schedulerContext, &next->context);
+        current = nullptr;
+        if (!alive(next)) releaseStack(next);
+    }
+    return stopCode;
+}
+
+void stop(int code) {
+    stopRequested = true;
+    stopCode = code;
+}
+
+uint32_t taskCount() {
+    uint32_t count = 0;
+    for (Tcb* task : tasks) count += alive(task);
+    return count;
+}
+
+} // namespace host
+
+// --- PROS C API ---
+uint32_t pros::c::millis() {
+    chargeClockRead();
+    return host::nowMs();
+}
+
+uint64_t pros::c::micros() {
+    chargeClockRead();
+    return clockUs;
+}
+
+task_t pros::c::task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t stack_depth,
+                            const char* const name) {
+    (void)stack_depth;
+    Tcb* task = new Tcb;
+    task->function = function;
+    task->parameters = parameters;
+    task->priority = prio;
+    std::snprintf(task->name, sizeof(task->name), "%s", name != nullptr ? name : "");
+
+    size_t page = sysconf(_SC_PAGESIZE);
+    task->mappingSize = HOST_STACK_SIZE + page;
+    task->stackMapping = mmap(nullptr, task->mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (task->stackMapping == MAP_FAILED) {
+        std::fprintf(stderr, "host: no memory for the stack of task %s\n", task->name);
+        std::abort();
+    }
+    mprotect(task->stackMapping, page, PROT_NONE); // Guard page; stacks grow down
+    getcontext(&task->context);
+    task->context.uc_stack.ss_sp = static_cast<char*>(task->stackMapping) + page;
+    task->context.uc_stack.ss_size = HOST_STACK_SIZE;
+    task->context.uc_link = nullptr;
+    makecontext(&task->context, taskEntry, 0);
+
+    makeReady(task);
+    tasks.push_back(task);
+    preemptIfNeeded();
+    return task;
+}
+
+void pros::c::task_delete(task_t task) {
+    Tcb* target = toTask(task);
+    if (target == nullptr) return;
+    deleteTask(target);
+    if (target == current) switchToScheduler(); // Never resumes
+}
+
+void pros::c::task_delay(const uint32_t milliseconds) {
+    if (current == nullptr) return;
+    if (milliseconds == 0) {
+        yieldCurrent();
+        return;
+    }
+    blockCurrent(Wait::DELAY, milliseconds);
+}
+
+void pros::c::delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void pros::c::task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    uint32_t wake = *prev_time + delta;
+    *prev_time = wake;
+    if (current == nullptr) return;
+    int32_t wait = static_cast<int32_t>(wake - host::nowMs());
+    if (wait <= 0) {
+        yieldCurrent();
+        return;
+    }
+    blockCurrent(Wait::DELAY, wait);
+}
+
+uint32_t pros::c::task_get_priority(task_t task) {
+    Tcb* target = toTask(task);
+    return target != nullptr ? target->priority : 0;
+}
+
+void pros::c::task_set_priority(task_t task, uint32_t prio) {
+    Tcb* target = toTask(task);
+    if (target == nullptr) return;
+    target->priority = prio;
+    preemptIfNeeded();
+}
+
+pros::task_state_e_t pros::c::task_get_state(task_t task) {
+    Tcb* target = toTask(task);
+    return target != nullptr ? target->state : E_TASK_STATE_INVALID;
+}
+
+void pros::c::task_suspend(task_t task) {
+    Tcb* target = toTask(task);
+    if (target == nullptr || !alive(target)) return;
+    target->state = E_TASK_STATE_SUSPENDED;
+    if (target == current) switchToScheduler();
+}
+
+void pros::c::task_resume(task_t task) {
+    Tcb* target = toTask(task);
+    if (target == nullptr || target->state != E_TASK_STATE_SUSPENDED) return;
+    makeReady(target);
+    preemptIfNeeded();
+}
+
+uint32_t pros::c::task_get_count() { return host::taskCount(); }
+
+char* pros::c::task_get_name(task_t task) {
+    Tcb* target = toTask(task);
+    return target != nullptr ? target->name : nullptr;
+}
+
+task_t pros::c::task_get_by_name(const char* name) {
+    for (Tcb* task : tasks) {
+        if (alive(task) && std::strcmp(task->name, name) == 0) return task;
+    }
+    return nullptr;
+}
+
+task_t pros::c::task_get_current() { return current; }
+
+uint32_t pros::c::task_notify(task_t task) { return task_notify_ext(task, 0, E_NOTIFY_ACTION_INCR, nullptr); }
+
+void pros::c::task_join(task_t task) {
+    Tcb* target = toTask(task);
+    if (current == nullptr || target == nullptr || target == current || !alive(target)) return;
+    current->joining = target;
+    blockCurrent(Wait::JOIN, TIMEOUT_MAX);
+}
+
+uint32_t pros::c::task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+    Tcb* target = toTask(task);
+    if (target == nullptr || !alive(target)) return 0;
+    if (prev_value != nullptr) *prev_value = target->notifyValue;
+    switch (action) {
+        case E_NOTIFY_ACTION_NONE: break;
+        case E_NOTIFY_ACTION_BITS: target->notifyValue |= value; break;
+        case E_NOTIFY_ACTION_INCR: target->notifyValue++; break;
+        case E_NOTIFY_ACTION_OWRITE: target->notifyValue = value; break;
+        case E_NOTIFY_ACTION_NO_OWRITE:
+            if (target->notifyPending) return 0;
+            target->notifyValue = value;
+            break;
+    }
+    target->notifyPending = true;
+    if (target->state == E_TASK_STATE_BLOCKED && target->wait == Wait::NOTIFY) {
+        makeReady(target);
+        preemptIfNeeded();
+    }
+    return 1;
+}
+
+uint32_t pros::c::task_notify_take(bool clear_on_exit, uint32_t timeout) {
+    if (current == nullptr) return 0;
+    if (current->notifyValue == 0 && timeout != 0) blockCurrent(Wait::NOTIFY, timeout);
+    uint32_t value = current->notifyValue;
+    if (value != 0) current->notifyValue = clear_on_exit ? 0 : value - 1;
+    current->notifyPending = false;
+    return value;
+}
+
+bool pros::c::task_notify_clear(task_t task) {
+    Tcb* target = toTask(task);
+    if (target == nullptr) return false;
+    bool pending = target->notifyPending;
+    target->notifyPending = false;
+    return pending;
+}
+
+mutex_t pros::c::mutex_create() { return new HostMutex; }
+
+bool pros::c::mutex_take(mutex_t mutex, uint32_t timeout) { return takeMutex(toMutex(mutex), timeout); }
+
+bool pros::c::mutex_give(mutex_t mutex) { return giveMutex(toMutex(mutex)); }
+
+mutex_t pros::c::mutex_recursive_create() {
+    HostMutex* mutex = new HostMutex;
+    mutex->recursive = true;
+    return mutex;
+}
+
+bool pros::c::mutex_recursive_take(mutex_t mutex, uint32_t timeout) { return takeMutex(toMutex(mutex), timeout); }
+
+bool pros::c::mutex_recursive_give(mutex_t mutex) { return giveMutex(toMutex(mutex)); }
+
+void pros::c::mutex_delete(mutex_t mutex) { delete toMutex(mutex); }
+
+// --- PROS C++ API ---
+namespace pros {
+inline namespace rtos {
+
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name)
+    : task(c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}
+
+Task Task::current() { return Task(c::task_get_current()); }
+
+Task& Task::operator=(task_t in) {
+    task = in;
+    return *this;
+}
+
+void Task::remove() { c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) { c::task_set_priority(task, prio); }
+
+std::uint32_t Task::get_state() { return c::task_get_state(task); }
+
+void Task::suspend() { c::task_suspend(task); }
+
+void Task::resume() { c::task_resume(task); }
+
+const char* Task::get_name() { return c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return c::task_notify(task); }
+
+void Task::join() { c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action, std::uint32_t* prev_value) {
+    return c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+    return c::task_notify_take(clear_on_exit, timeout);
+}
+
+bool Task::notify_clear() { return c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) { c::task_delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    c::task_delay_until(prev_time, delta);
+}
+
+std::uint32_t Task::get_count() { return c::task_get_count(); }
+
+Clock::time_point Clock::now() { return time_point {duration {c::millis()}}; }
+
+mutex_t Mutex::lazy_init() {
+    mutex_t existing = mutex.load();
+    if (existing != nullptr) return existing;
+    mutex_t created = c::mutex_create();
+    if (mutex.compare_exchange_strong(existing, created)) return created;
+    c::mutex_delete(created);
+    return existing;
+}
+
+bool Mutex::take() { return c::mutex_take(lazy_init(), TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) { return c::mutex_take(lazy_init(), timeout); }
+
+bool Mutex::give() { return c::mutex_give(lazy_init()); }
+
+void Mutex::lock() { take(TIMEOUT_MAX); }
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+Mutex::~Mutex() { c::mutex_delete(mutex.load()); }
+
+mutex_t RecursiveMutex::lazy_init() {
+    mutex_t existing = mutex.load();
+    if (existing != nullptr) return existing;
+    mutex_t created = c::mutex_recursive_create();
+    if (mutex.compare_exchange_strong(existing, created)) return created;
+    c::mutex_delete(created);
+    return existing;
+}
+
+bool RecursiveMutex::take() { return c::mutex_recursive_take(lazy_init(), TIMEOUT_MAX); }
+
+bool RecursiveMutex::take(std::uint32_t timeout) { return c::mutex_recursive_take(lazy_init(), timeout); }
+
+bool RecursiveMutex::give() { return c::mutex_recursive_give(lazy_init()); }
+
+void RecursiveMutex::lock() { take(TIMEOUT_MAX); }
+
+void RecursiveMutex::unlock() { give(); }
+
+bool RecursiveMutex::try_lock() { return take(0); }
+
+RecursiveMutex::~RecursiveMutex() { c::mutex_delete(mutex.load()); }
+
+} // namespace rtos
+} // namespace pros
@@ -0,0 +1,40 @@
+#ifndef HOST_KERNEL_HPP
+#define HOST_KERNEL_HPP
+
+#include <cstdint>
+#include <functional>
+
+// --- Host Kernel ---
+// Stand-in for the brain's FreeRTOS, so the robot program runs unchanged on a Linux host. Every PROS task is a
+// coroutine on one host thread and time is virtual: it only moves forward when every task is blocked (the clock
+// then jumps to the next 1 ms tick) or when a task busy-waits on the clock (each read costs CLOCK_READ_COST_US).
+// Runs are therefore deterministic and as fast as the host can execute the robot code.
+//
+// Scheduling follows FreeRTOS: the highest-priority ready task runs until it blocks; equal priorities run in the
+// order they became ready and are time-sliced at each tick; waking a higher-priority task preempts the caller.
+// Deleted tasks are abandoned where they stopped, like on the brain (no destructors run, held mutexes stay held).
+
+namespace host {
+
+// Virtual time a busy-waiting task spends on one millis()/micros() call
+constexpr uint32_t CLOCK_READ_COST_US = 1;
+
+// Called once per tick, before any task wakes for it, with the new time in ms. The world model lives here.
+using TickHook = std::function<void(uint32_t now)>;
+void setTickHook(TickHook hook);
+
+// Current virtual time
+uint64_t nowUs();
+uint32_t nowMs();
+
+// Runs the scheduler until stop() is called or `until` (ms) is reached. Returns the stop code, or -1 on timeout.
+int run(uint32_t until);
+// Ends run() once the calling task blocks next (or at once from the tick hook)
+void stop(int code);
+
+// Tasks that exist and have not been deleted
+uint32_t taskCount();
+
+} // namespace host
+
+#endif
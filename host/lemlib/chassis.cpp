@@ -0,0 +1,169 @@
+// Chassis setup, pose access, motion queueing and driver control of the host LemLib
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.h"
+#include <cmath>
+
+// IMU calibration attempts before odometry falls back to the drivetrain
+#define IMU_CALIBRATION_RETRIES 5
+
+namespace lemlib {
+
+OdomSensors::OdomSensors(TrackingWheel* vertical1, TrackingWheel* vertical2, TrackingWheel* horizontal1,
+                         TrackingWheel* horizontal2, pros::Imu* imu)
+    : vertical1(vertical1), vertical2(vertical2), horizontal1(horizontal1), horizontal2(horizontal2), imu(imu) {}
+
+Drivetrain::Drivetrain(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, float trackWidth,
+                       float wheelDiameter, float rpm, float horizontalDrift)
+    : leftMotors(leftMotors), rightMotors(rightMotors), trackWidth(trackWidth), wheelDiameter(wheelDiameter),
+      rpm(rpm), horizontalDrift(horizontalDrift) {}
+
+Chassis::Chassis(Drivetrain drivetrain, ControllerSettings linearSettings, ControllerSettings angularSettings,
+                 OdomSensors sensors, DriveCurve* throttleCurve, DriveCurve* steerCurve)
+    : lateralPID(linearSettings.kP, linearSettings.kI, linearSettings.kD, linearSettings.windupRange, true),
+      angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange, true),
+      lateralSettings(linearSettings), angularSettings(angularSettings), drivetrain(drivetrain), sensors(sensors),
+      throttleCurve(throttleCurve), steerCurve(steerCurve),
+      lateralLargeExit(linearSettings.largeError, linearSettings.largeErrorTimeout),
+      lateralSmallExit(linearSettings.smallError, linearSettings.smallErrorTimeout),
+      angularLargeExit(angularSettings.largeError, angularSettings.largeErrorTimeout),
+      angularSmallExit(angularSettings.smallError, angularSettings.smallErrorTimeout) {}
+
+void Chassis::calibrate(bool calibrateIMU) {
+    if (calibrateIMU && sensors.imu != nullptr) {
+        int attempt = 1;
+        for (; attempt <= IMU_CALIBRATION_RETRIES; attempt++) {
+            sensors.imu->reset();
+            do pros::delay(10);
+            while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+            const double heading = sensors.imu->get_heading();
+            if (!std::isnan(heading) && !std::isinf(heading)) break;
+            pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
+        }
+        if (attempt > IMU_CALIBRATION_RETRIES) sensors.imu = nullptr;
+    }
+    // Without vertical wheels the drive motors stand in for them
+    if (sensors.vertical1 == nullptr) {
+        sensors.vertical1 = new TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                              -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    }
+    if (sensors.vertical2 == nullptr) {
+        sensors.vertical2 = new TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                              drivetrain.trackWidth / 2, drivetrain.rpm);
+    }
+    sensors.vertical1->reset();
+    sensors.vertical2->reset();
+    if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+    if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+    setSensors(sensors, drivetrain);
+    init();
+    pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+}
+
+void Chassis::setPose(float x, float y, float theta, bool radians) { lemlib::setPose(Pose(x, y, theta), radians); }
+
+void Chassis::setPose(Pose pose, bool radians) { lemlib::setPose(pose, radians); }
+
+Pose Chassis::getPose(bool radians, bool standardPos) {
+    Pose pose = lemlib::getPose(true);
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+void Chassis::resetLocalPosition() {
+    const float theta = getPose().theta;
+    lemlib::setPose(Pose(0, 0, theta), false);
+}
+
+void Chassis::setBrakeMode(pros::motor_brake_mode_e mode) {
+    drivetrain.leftMotors->set_brake_mode_all(mode);
+    drivetrain.rightMotors->set_brake_mode_all(mode);
+}
+
+// --- Motion queue ---
+// The mutex orders motions: a new one waits for the running one to end (or be cancelled)
+void Chassis::requestMotionStart() {
+    if (isInMotion()) motionQueued = true;
+    else motionRunning = true;
+    mutex.take(TIMEOUT_MAX);
+}
+
+void Chassis::endMotion() {
+    motionRunning = motionQueued;
+    motionQueued = false;
+    mutex.give();
+}
+
+void Chassis::waitUntil(float dist) {
+    pros::delay(10);
+    while (distTraveled < dist && distTraveled != -1) pros::delay(10);
+}
+
+void Chassis::waitUntilDone() {
+    do pros::delay(10);
+    while (distTraveled != -1);
+}
+
+void Chassis::cancelMotion() {
+    motionRunning = false;
+    pros::delay(10);
+}
+
+void Chassis::cancelAllMotions() {
+    motionRunning = false;
+    motionQueued = false;
+    pros::delay(10);
+}
+
+bool Chassis::isInMotion() const { return motionRunning; }
+
+// --- Driver control ---
+void Chassis::tank(int left, int right, bool disableDriveCurve) {
+    if (!disableDriveCurve) {
+        left = throttleCurve->curve(left);
+        right = throttleCurve->curve(right);
+    }
+    drivetrain.leftMotors->move(left);
+    drivetrain.rightMotors->move(right);
+}
+
+void Chassis::arcade(int throttle, int turn, bool disableDriveCurve, float desaturateBias) {
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+    // Give up some of each input when together they would saturate
+    if (std::abs(throttle) + std::abs(turn) > 127) {
+        const int oldThrottle = throttle;
+        const int oldTurn = turn;
+        throttle *= 1 - desaturateBias * std::abs(oldTurn / 127.0);
+        turn *= 1 - (1 - desaturateBias) * std::abs(oldThrottle / 127.0);
+    }
+    drivetrain.leftMotors->move(throttle + turn);
+    drivetrain.rightMotors->move(throttle - turn);
+}
+
+void Chassis::curvature(int throttle, int turn, bool disableDriveCurve) {
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+    if (throttle == 0) {
+        drivetrain.leftMotors->move(turn);
+        drivetrain.rightMotors->move(-turn);
+        return;
+    }
+    double leftPower = throttle + std::abs(throttle) * turn / 127.0;
+    double rightPower = throttle - std::abs(throttle) * turn / 127.0;
+    const double maxPower = std::max(std::abs(leftPower), std::abs(rightPower));
+    if (maxPower > 127) {
+        leftPower = 127 * leftPower / maxPower;
+        rightPower = 127 * rightPower / maxPower;
+    }
+    drivetrain.leftMotors->move(leftPower);
+    drivetrain.rightMotors->move(rightPower);
+}
+
+} // namespace lemlib
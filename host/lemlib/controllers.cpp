@@ -0,0 +1,108 @@
+// PID, exit conditions, timer and drive curves of the host LemLib
+#include "lemlib/exitcondition.hpp"
+#include "lemlib/pid.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp" // Also brings in driveCurve.hpp, which has no include guard
+#include "pros/rtos.hpp"
+#include <cmath>
+
+namespace lemlib {
+
+// --- PID ---
+PID::PID(float kP, float kI, float kD, float windupRange, bool signFlipReset)
+    : kP(kP), kI(kI), kD(kD), windupRange(windupRange), signFlipReset(signFlipReset) {}
+
+float PID::update(const float error) {
+    integral += error;
+    if (sgn(error) != sgn(prevError) && signFlipReset) integral = 0;
+    if (std::fabs(error) > windupRange && windupRange != 0) integral = 0;
+    const float derivative = error - prevError;
+    prevError = error;
+    return error * kP + integral * kI + derivative * kD;
+}
+
+void PID::reset() {
+    integral = 0;
+    prevError = 0;
+}
+
+// --- ExitCondition ---
+ExitCondition::ExitCondition(const float range, const int time) : range(range), time(time) {}
+
+bool ExitCondition::getExit() { return done; }
+
+bool ExitCondition::update(const float input) {
+    const int now = pros::millis();
+    if (std::fabs(input) > range) startTime = -1;
+    else if (startTime == -1) startTime = now;
+    else if (now >= startTime + time) done = true;
+    return done;
+}
+
+void ExitCondition::reset() {
+    startTime = -1;
+    done = false;
+}
+
+// --- Timer ---
+// Every query first adds the time since the last one, unless paused
+Timer::Timer(uint32_t time) : period(time), lastTime(pros::millis()) {}
+
+uint32_t Timer::getTimeSet() { return period; }
+
+uint32_t Timer::getTimeLeft() {
+    const uint32_t passed = getTimePassed();
+    return passed < period ? period - passed : 0;
+}
+
+uint32_t Timer::getTimePassed() {
+    const uint32_t now = pros::millis();
+    if (!paused) timeWaited += now - lastTime;
+    lastTime = now;
+    return timeWaited;
+}
+
+bool Timer::isDone() { return getTimePassed() >= period; }
+
+bool Timer::isPaused() { return paused; }
+
+void Timer::set(uint32_t time) {
+    period = time;
+    reset();
+}
+
+void Timer::reset() {
+    timeWaited = 0;
+    lastTime = pros::millis();
+}
+
+void Timer::pause() {
+    getTimePassed();
+    paused = true;
+}
+
+void Timer::resume() {
+    getTimePassed();
+    paused = false;
+}
+
+void Timer::waitUntilDone() {
+    while (!isDone()) pros::delay(5);
+}
+
+// --- Drive curves ---
+ExpoDriveCurve::ExpoDriveCurve(float deadband, float minOutput, float curve)
+    : deadband(deadband), minOutput(minOutput), curveGain(curve) {}
+
+float ExpoDriveCurve::curve(float input) {
+    if (std::fabs(input) <= deadband) return 0;
+    const float g = std::fabs(input) - deadband;
+    const float g127 = 127 - deadband;
+    const float i = std::pow(curveGain, g - 127) * g * sgn(input);
+    const float i127 = std::pow(curveGain, g127 - 127) * g127;
+    return (127.0 - minOutput) / 127 * i * 127 / i127 + minOutput * sgn(input);
+}
+
+ExpoDriveCurve defaultDriveCurve(0, 0, 1);
+
+} // namespace lemlib
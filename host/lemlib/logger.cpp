@@ -0,0 +1,26 @@
+#include "lemlib/logger/baseSink.hpp"
+
+namespace lemlib {
+
+BaseSink::BaseSink(std::initializer_list<std::shared_ptr<BaseSink>> sinks) : sinks(sinks) {}
+
+void BaseSink::setLowestLevel(Level level) { lowestLevel = level; }
+
+void BaseSink::setFormat(const std::string& format) { logFormat = format; }
+
+fmt::dynamic_format_arg_store<fmt::format_context> BaseSink::getExtraFormattingArgs(const Message&) { return {}; }
+
+void BaseSink::sendMessage(const Message&) {}
+
+std::string format_as(Level level) {
+    switch (level) {
+        case Level::INFO: return "INFO";
+        case Level::DEBUG: return "DEBUG";
+        case Level::WARN: return "WARN";
+        case Level::ERROR: return "ERROR";
+        case Level::FATAL: return "FATAL";
+    }
+    return "UNKNOWN";
+}
+
+} // namespace lemlib
@@ -0,0 +1,336 @@
+// Turns, swings, move to point and move to pose of the host LemLib. Every motion runs a 10 ms loop until its exit
+// conditions, its timeout, a cancel or a change of competition state, then stops the drivetrain and sets
+// distTraveled to -1.
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+
+namespace lemlib {
+
+// Waits for the chassis, then either returns false so the caller runs the motion itself, or returns true when the
+// motion was cancelled while queued or has been handed to its own task (async)
+bool claimChassis(Chassis& chassis, bool async, std::function<void()> motion) {
+    chassis.requestMotionStart();
+    if (!chassis.motionRunning) {
+        chassis.endMotion();
+        return true;
+    }
+    if (!async) return false;
+    pros::Task task(std::move(motion));
+    chassis.endMotion();
+    pros::delay(10); // Let the task start and queue itself
+    return true;
+}
+
+void finishMotion(Chassis& chassis) {
+    chassis.drivetrain.leftMotors->move(0);
+    chassis.drivetrain.rightMotors->move(0);
+    chassis.distTraveled = -1;
+    chassis.endMotion();
+}
+
+namespace {
+
+// Shared by turns and swings. `target` returns the target heading (degrees) for the current pose, `drive` applies
+// the angular power (positive turns clockwise).
+template <typename Target, typename Drive>
+void turnLoop(Chassis& chassis, int timeout, bool forwards, AngularDirection direction, float maxSpeed,
+              float minSpeed, float earlyExitRange, Target target, Drive drive) {
+    minSpeed = std::fabs(minSpeed);
+    float prevMotorPower = 0;
+    const float startTheta = chassis.getPose().theta;
+    bool settling = false;
+    std::optional<float> prevRawDeltaTheta;
+    std::optional<float> prevDeltaTheta;
+    const uint8_t compState = pros::competition::get_status();
+    chassis.distTraveled = 0;
+    Timer timer(timeout);
+    chassis.angularLargeExit.reset();
+    chassis.angularSmallExit.reset();
+    chassis.angularPID.reset();
+
+    while (!timer.isDone() && !chassis.angularLargeExit.getExit() && !chassis.angularSmallExit.getExit() &&
+           chassis.motionRunning && pros::competition::get_status() == compState) {
+        Pose pose = chassis.getPose();
+        pose.theta = forwards ? std::fmod(pose.theta, 360) : std::fmod(pose.theta - 180, 360);
+        chassis.distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+        const float targetTheta = target(pose);
+
+        // Once the robot has crossed the target, settle by the shortest way regardless of the requested direction
+        const float rawDeltaTheta = angleError(targetTheta, pose.theta, false);
+        if (!prevRawDeltaTheta) prevRawDeltaTheta = rawDeltaTheta;
+        if (sgn(rawDeltaTheta) != sgn(*prevRawDeltaTheta)) settling = true;
+        prevRawDeltaTheta = rawDeltaTheta;
+        const float deltaTheta = settling ? rawDeltaTheta : angleError(targetTheta, pose.theta, false, direction);
+        if (!prevDeltaTheta) prevDeltaTheta = deltaTheta;
+
+        // Motion chaining
+        if (minSpeed != 0 && std::fabs(deltaTheta) < earlyExitRange) break;
+        if (minSpeed != 0 && sgn(deltaTheta) != sgn(*prevDeltaTheta)) break;
+
+        float motorPower = chassis.angularPID.update(deltaTheta);
+        chassis.angularLargeExit.update(deltaTheta);
+        chassis.angularSmallExit.update(deltaTheta);
+
+        motorPower = std::clamp(motorPower, -maxSpeed, maxSpeed);
+        if (std::fabs(deltaTheta) > 20) motorPower = slew(motorPower, prevMotorPower, chassis.angularSettings.slew);
+        if (motorPower < 0 && motorPower > -minSpeed) motorPower = -minSpeed;
+        else if (motorPower > 0 && motorPower < minSpeed) motorPower = minSpeed;
+        prevMotorPower = motorPower;
+
+        drive(motorPower);
+        pros::delay(10);
+    }
+}
+
+// Target heading (degrees) that points the robot at (x, y)
+float headingTo(const Pose& pose, float x, float y) {
+    return std::fmod(radToDeg(M_PI_2 - pose.angle(Pose(x, y))), 360);
+}
+
+// Swings keep one side held still and drive the other
+template <typename Target>
+void swing(Chassis& chassis, DriveSide lockedSide, int timeout, bool forwards, AngularDirection direction,
+           float maxSpeed, float minSpeed, float earlyExitRange, Target target) {
+    pros::MotorGroup* locked =
+        lockedSide == DriveSide::LEFT ? chassis.drivetrain.leftMotors : chassis.drivetrain.rightMotors;
+    const pros::MotorBrake brakeMode = locked->get_brake_mode();
+    locked->set_brake_mode_all(pros::MotorBrake::hold);
+    turnLoop(chassis, timeout, forwards, direction, maxSpeed, minSpeed, earlyExitRange, target, [&](float power) {
+        if (lockedSide == DriveSide::LEFT) chassis.drivetrain.rightMotors->move(-power);
+        else chassis.drivetrain.leftMotors->move(power);
+        locked->brake();
+    });
+    chassis.drivetrain.leftMotors->move(0);
+    chassis.drivetrain.rightMotors->move(0);
+    locked->set_brake_mode_all(brakeMode);
+}
+
+} // namespace
+
+// --- Turns ---
+void Chassis::turnToHeading(float theta, int timeout, TurnToHeadingParams params, bool async) {
+    if (claimChassis(*this, async, [=, this] { turnToHeading(theta, timeout, params, false); })) return;
+    turnLoop(*this, timeout, true, params.direction, params.maxSpeed, params.minSpeed, params.earlyExitRange,
+             [&](const Pose&) { return theta; }, [&](float power) {
+                 drivetrain.leftMotors->move(power);
+                 drivetrain.rightMotors->move(-power);
+             });
+    finishMotion(*this);
+}
+
+void Chassis::turnToPoint(float x, float y, int timeout, TurnToPointParams params, bool async) {
+    if (claimChassis(*this, async, [=, this] { turnToPoint(x, y, timeout, params, false); })) return;
+    turnLoop(*this, timeout, params.forwards, params.direction, params.maxSpeed, params.minSpeed,
+             params.earlyExitRange, [&](const Pose& pose) { return headingTo(pose, x, y); }, [&](float power) {
+                 drivetrain.leftMotors->move(power);
+                 drivetrain.rightMotors->move(-power);
+             });
+    finishMotion(*this);
+}
+
+void Chassis::swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params,
+                             bool async) {
+    if (claimChassis(*this, async, [=, this] { swingToHeading(theta, lockedSide, timeout, params, false); })) return;
+    swing(*this, lockedSide, timeout, true, params.direction, params.maxSpeed, params.minSpeed, params.earlyExitRange,
+          [&](const Pose&) { return theta; });
+    finishMotion(*this);
+}
+
+void Chassis::swingToPoint(float x, float y, DriveSide lockedSide, int timeout, SwingToPointParams params,
+                           bool async) {
+    if (claimChassis(*this, async, [=, this] { swingToPoint(x, y, lockedSide, timeout, params, false); })) return;
+    swing(*this, lockedSide, timeout, params.forwards, params.direction, params.maxSpeed, params.minSpeed,
+          params.earlyExitRange, [&](const Pose& pose) { return headingTo(pose, x, y); });
+    finishMotion(*this);
+}
+
+// --- Lateral motions ---
+// Both work in standard position (radians, counter-clockwise from +x)
+
+namespace {
+
+// True when `point` is behind the line through `target` perpendicular to its heading (moved by `earlyExit`)
+bool behind(const Pose& point, const Pose& target, float earlyExit) {
+    return (point.y - target.y) * -std::sin(target.theta) <=
+           (point.x - target.x) * std::cos(target.theta) + earlyExit;
+}
+
+// Drives with the outputs scaled down together so neither side exceeds maxSpeed
+void driveRatioed(Chassis& chassis, float lateralOut, float angularOut, float maxSpeed) {
+    float leftPower = lateralOut + angularOut;
+    float rightPower = lateralOut - angularOut;
+    const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / maxSpeed;
+    if (ratio > 1) {
+        leftPower /= ratio;
+        rightPower /= ratio;
+    }
+    chassis.drivetrain.leftMotors->move(leftPower);
+    chassis.drivetrain.rightMotors->move(rightPower);
+}
+
+float applyMinSpeed(float lateralOut, bool forwards, float minSpeed) {
+    minSpeed = std::fabs(minSpeed);
+    if (forwards && lateralOut > 0 && lateralOut < minSpeed) return minSpeed;
+    if (!forwards && lateralOut < 0 && -lateralOut < minSpeed) return -minSpeed;
+    return lateralOut;
+}
+
+} // namespace
+
+void Chassis::moveToPoint(float x, float y, int timeout, MoveToPointParams params, bool async) {
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    if (claimChassis(*this, async, [=, this] { moveToPoint(x, y, timeout, params, false); })) return;
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+
+    Pose lastPose = getPose();
+    distTraveled = 0;
+    Timer timer(timeout);
+    bool close = false;
+    float prevLateralOut = 0;
+    float prevAngularOut = 0;
+    const uint8_t compState = pros::competition::get_status();
+    std::optional<bool> prevSide;
+    Pose target(x, y);
+    target.theta = lastPose.angle(target);
+
+    while (!timer.isDone() && ((!lateralSmallExit.getExit() && !lateralLargeExit.getExit()) || !close) &&
+           motionRunning && pros::competition::get_status() == compState) {
+        const Pose pose = getPose(true, true);
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // Settle on the point with a reduced speed cap once close
+        if (pose.distance(target) < 7.5 && !close) {
+            close = true;
+            params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+        }
+
+        // Motion chaining: exit once the robot crosses the target line
+        const bool side = behind(pose, target, params.earlyExitRange);
+        if (!prevSide) prevSide = side;
+        if (side != *prevSide && params.minSpeed != 0) break;
+        prevSide = side;
+
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError = angleError(adjustedRobotTheta, pose.angle(target));
+        const float lateralError = pose.distance(target) * std::cos(angleError(pose.theta, pose.angle(target)));
+        lateralSmallExit.update(lateralError);
+        lateralLargeExit.update(lateralError);
+
+        float lateralOut = lateralPID.update(lateralError);
+        float angularOut = close ? 0 : angularPID.update(radToDeg(angularError));
+
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+        angularOut = slew(angularOut, prevAngularOut, angularSettings.slew);
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+        if (!close) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+        // Never reverse before settling
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+        lateralOut = applyMinSpeed(lateralOut, params.forwards, params.minSpeed);
+        prevAngularOut = angularOut;
+        prevLateralOut = lateralOut;
+
+        driveRatioed(*this, lateralOut, angularOut, params.maxSpeed);
+        pros::delay(10);
+    }
+    finishMotion(*this);
+}
+
+// Boomerang: chase a carrot point that leads the robot into the target heading
+void Chassis::moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params, bool async) {
+    if (claimChassis(*this, async, [=, this] { moveToPose(x, y, theta, timeout, params, false); })) return;
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+
+    Pose target(x, y, M_PI_2 - degToRad(theta));
+    if (!params.forwards) target.theta = std::fmod(target.theta + M_PI, 2 * M_PI);
+    if (params.horizontalDrift == 0) params.horizontalDrift = drivetrain.horizontalDrift;
+
+    Pose lastPose = getPose();
+    distTraveled = 0;
+    Timer timer(timeout);
+    bool close = false;
+    bool lateralSettled = false;
+    bool prevSameSide = false;
+    float prevLateralOut = 0;
+    float prevAngularOut = 0;
+    const uint8_t compState = pros::competition::get_status();
+
+    while (!timer.isDone() &&
+           (!lateralSettled || (!angularLargeExit.getExit() && !angularSmallExit.getExit()) || !close) &&
+           motionRunning && pros::competition::get_status() == compState) {
+        const Pose pose = getPose(true, true);
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        const float distTarget = pose.distance(target);
+        if (distTarget < 7.5 && !close) {
+            close = true;
+            params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+        }
+        if (lateralLargeExit.getExit() && lateralSmallExit.getExit()) lateralSettled = true;
+
+        Pose carrot = target - Pose(std::cos(target.theta), std::sin(target.theta)) * params.lead * distTarget;
+        if (close) carrot = target;
+
+        // Motion chaining: exit once the robot and the carrot end up on different sides of the target line
+        const bool sameSide =
+            behind(pose, target, params.earlyExitRange) == behind(carrot, target, params.earlyExitRange);
+        if (!sameSide && prevSameSide && close && params.minSpeed != 0) break;
+        prevSameSide = sameSide;
+
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError = close ? angleError(adjustedRobotTheta, target.theta)
+                                         : angleError(adjustedRobotTheta, pose.angle(carrot));
+        // Full cosine scaling only while settling; before that maxSlipSpeed limits the lateral output
+        float lateralError = pose.distance(carrot);
+        const float carrotCos = std::cos(angleError(pose.theta, pose.angle(carrot)));
+        lateralError *= close ? carrotCos : sgn(carrotCos);
+
+        lateralSmallExit.update(lateralError);
+        lateralLargeExit.update(lateralError);
+        angularSmallExit.update(radToDeg(angularError));
+        angularLargeExit.update(radToDeg(angularError));
+
+        float lateralOut = lateralPID.update(lateralError);
+        float angularOut = angularPID.update(radToDeg(angularError));
+
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+        angularOut = slew(angularOut, prevAngularOut, angularSettings.slew);
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+        if (!close) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+
+        // Fastest the robot can take the carrot arc without sliding sideways
+        const float radius = 1 / std::fabs(getCurvature(pose, carrot));
+        const float maxSlipSpeed = std::sqrt(params.horizontalDrift * radius * 9.8);
+        lateralOut = std::clamp(lateralOut, -maxSlipSpeed, maxSlipSpeed);
+        // Turning wins over driving
+        const float overturn = std::fabs(angularOut) + std::fabs(lateralOut) - params.maxSpeed;
+        if (overturn > 0) lateralOut -= lateralOut > 0 ? overturn : -overturn;
+        lateralOut = applyMinSpeed(lateralOut, params.forwards, params.minSpeed);
+        prevAngularOut = angularOut;
+        prevLateralOut = lateralOut;
+
+        driveRatioed(*this, lateralOut, angularOut, params.maxSpeed);
+        pros::delay(10);
+    }
+    finishMotion(*this);
+}
+
+} // namespace lemlib
@@ -0,0 +1,174 @@
+// Tracking wheels and odometry of the host LemLib
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+
+namespace lemlib {
+
+// --- TrackingWheel ---
+// The robot has no ADI encoders, so the ADI constructor is left out of the host build
+TrackingWheel::TrackingWheel(pros::Rotation* encoder, float wheelDiameter, float distance, float gearRatio)
+    : diameter(wheelDiameter), distance(distance), rotation(encoder), gearRatio(gearRatio) {}
+
+TrackingWheel::TrackingWheel(pros::MotorGroup* motors, float wheelDiameter, float distance, float rpm)
+    : diameter(wheelDiameter), distance(distance), rpm(rpm), motors(motors) {
+    motors->set_encoder_units_all(pros::E_MOTOR_ENCODER_ROTATIONS);
+}
+
+void TrackingWheel::reset() {
+    if (rotation != nullptr) rotation->reset_position();
+    if (motors != nullptr) motors->tare_position_all();
+}
+
+float TrackingWheel::getDistanceTraveled() {
+    if (rotation != nullptr) return float(rotation->get_position()) * diameter * M_PI / 36000 / gearRatio;
+    if (motors == nullptr) return 0;
+    // Each motor's distance from its own cartridge, then the average
+    std::vector<pros::MotorGears> gearsets = motors->get_gearing_all();
+    std::vector<double> positions = motors->get_position_all();
+    std::vector<float> distances;
+    for (size_t i = 0; i < positions.size(); i++) {
+        float cartridge;
+        switch (gearsets[i]) {
+            case pros::MotorGears::red: cartridge = 100; break;
+            case pros::MotorGears::blue: cartridge = 600; break;
+            default: cartridge = 200; break;
+        }
+        distances.push_back(positions[i] * diameter * M_PI * (rpm / cartridge));
+    }
+    return avg(distances);
+}
+
+float TrackingWheel::getOffset() { return distance; }
+
+int TrackingWheel::getType() { return motors != nullptr ? 1 : 0; }
+
+// --- Odometry ---
+// Poses are kept in radians, heading clockwise from +y
+static OdomSensors odomSensors(nullptr, nullptr, nullptr, nullptr, nullptr);
+static Drivetrain drive(nullptr, nullptr, 0, 0, 0, 0);
+static Pose odomPose(0, 0, 0);
+static Pose odomSpeed(0, 0, 0);
+static Pose odomLocalSpeed(0, 0, 0);
+static pros::Task* trackingTask = nullptr;
+
+static float prevVertical = 0, prevVertical1 = 0, prevVertical2 = 0;
+static float prevHorizontal = 0, prevHorizontal1 = 0, prevHorizontal2 = 0;
+static float prevImu = 0;
+
+void setSensors(OdomSensors sensors, Drivetrain drivetrain) {
+    odomSensors = sensors;
+    drive = drivetrain;
+}
+
+static Pose toUnits(Pose pose, bool radians) {
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+Pose getPose(bool radians) { return toUnits(odomPose, radians); }
+
+void setPose(Pose pose, bool radians) {
+    if (!radians) pose.theta = degToRad(pose.theta);
+    odomPose = pose;
+}
+
+Pose getSpeed(bool radians) { return toUnits(odomSpeed, radians); }
+
+Pose getLocalSpeed(bool radians) { return toUnits(odomLocalSpeed, radians); }
+
+Pose estimatePose(float time, bool radians) {
+    const Pose local = getLocalSpeed(true) * time;
+    Pose pose = odomPose + local.rotate(odomPose.theta);
+    pose.theta = odomPose.theta + odomLocalSpeed.theta * time;
+    return toUnits(pose, radians);
+}
+
+static float distanceOf(TrackingWheel* wheel) { return wheel != nullptr ? wheel->getDistanceTraveled() : 0; }
+
+void update() {
+    const float vertical1Raw = distanceOf(odomSensors.vertical1);
+    const float vertical2Raw = distanceOf(odomSensors.vertical2);
+    const float horizontal1Raw = distanceOf(odomSensors.horizontal1);
+    const float horizontal2Raw = distanceOf(odomSensors.horizontal2);
+    const float imuRaw = odomSensors.imu != nullptr ? degToRad(odomSensors.imu->get_rotation()) : 0;
+
+    const float deltaVertical1 = vertical1Raw - prevVertical1;
+    const float deltaVertical2 = vertical2Raw - prevVertical2;
+    const float deltaHorizontal1 = horizontal1Raw - prevHorizontal1;
+    const float deltaHorizontal2 = horizontal2Raw - prevHorizontal2;
+    const float deltaImu = imuRaw - prevImu;
+    prevVertical1 = vertical1Raw;
+    prevVertical2 = vertical2Raw;
+    prevHorizontal1 = horizontal1Raw;
+    prevHorizontal2 = horizontal2Raw;
+    prevImu = imuRaw;
+
+    // Heading: two horizontal wheels, then two unpowered vertical wheels, then the IMU, then the drivetrain
+    float heading = odomPose.theta;
+    if (odomSensors.horizontal1 != nullptr && odomSensors.horizontal2 != nullptr) {
+        heading -= (deltaHorizontal1 - deltaHorizontal2) /
+                   (odomSensors.horizontal1->getOffset() - odomSensors.horizontal2->getOffset());
+    } else if (odomSensors.vertical1 != nullptr && odomSensors.vertical2 != nullptr &&
+               !odomSensors.vertical1->getType() && !odomSensors.vertical2->getType()) {
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    } else if (odomSensors.imu != nullptr) {
+        heading += deltaImu;
+    } else if (odomSensors.vertical1 != nullptr && odomSensors.vertical2 != nullptr) {
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    }
+    const float deltaHeading = heading - odomPose.theta;
+    const float avgHeading = odomPose.theta + deltaHeading / 2;
+
+    // Position: prefer unpowered wheels
+    TrackingWheel* verticalWheel = nullptr;
+    if (odomSensors.vertical1 != nullptr && !odomSensors.vertical1->getType()) verticalWheel = odomSensors.vertical1;
+    else if (odomSensors.vertical2 != nullptr && !odomSensors.vertical2->getType()) verticalWheel = odomSensors.vertical2;
+    else verticalWheel = odomSensors.vertical1;
+    TrackingWheel* horizontalWheel =
+        odomSensors.horizontal1 != nullptr ? odomSensors.horizontal1 : odomSensors.horizontal2;
+
+    const float rawVertical = distanceOf(verticalWheel);
+    const float rawHorizontal = distanceOf(horizontalWheel);
+    const float verticalOffset = verticalWheel != nullptr ? verticalWheel->getOffset() : 0;
+    const float horizontalOffset = horizontalWheel != nullptr ? horizontalWheel->getOffset() : 0;
+    const float deltaY = verticalWheel != nullptr ? rawVertical - prevVertical : 0;
+    const float deltaX = horizontalWheel != nullptr ? rawHorizontal - prevHorizontal : 0;
+    prevVertical = rawVertical;
+    prevHorizontal = rawHorizontal;
+
+    // Arc from the wheel travel, corrected for the wheels' offsets from the tracking center
+    float localX = deltaX;
+    float localY = deltaY;
+    if (deltaHeading != 0) {
+        localX = 2 * std::sin(deltaHeading / 2) * (deltaX / deltaHeading + horizontalOffset);
+        localY = 2 * std::sin(deltaHeading / 2) * (deltaY / deltaHeading + verticalOffset);
+    }
+
+    const Pose prevPose = odomPose;
+    odomPose.x += localY * std::sin(avgHeading) - localX * std::cos(avgHeading);
+    odomPose.y += localY * std::cos(avgHeading) + localX * std::sin(avgHeading);
+    odomPose.theta = heading;
+
+    odomSpeed.x = ema((odomPose.x - prevPose.x) / 0.01, odomSpeed.x, 0.95);
+    odomSpeed.y = ema((odomPose.y - prevPose.y) / 0.01, odomSpeed.y, 0.95);
+    odomSpeed.theta = ema((odomPose.theta - prevPose.theta) / 0.01, odomSpeed.theta, 0.95);
+    odomLocalSpeed.x = ema(localX / 0.01, odomLocalSpeed.x, 0.95);
+    odomLocalSpeed.y = ema(localY / 0.01, odomLocalSpeed.y, 0.95);
+    odomLocalSpeed.theta = ema(deltaHeading / 0.01, odomLocalSpeed.theta, 0.95);
+}
+
+void init() {
+    if (trackingTask != nullptr) return;
+    trackingTask = new pros::Task([] {
+        while (true) {
+            update();
+            pros::delay(10);
+        }
+    });
+}
+
+} // namespace lemlib
@@ -0,0 +1,129 @@
+// Pure pursuit path following of the host LemLib
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace lemlib {
+
+bool claimChassis(Chassis& chassis, bool async, std::function<void()> motion);
+void finishMotion(Chassis& chassis);
+
+namespace {
+
+// Path file lines are "x, y, speed" up to "endData"; the speed goes in theta
+std::vector<Pose> getData(const asset& path) {
+    std::vector<Pose> points;
+    std::istringstream lines(std::string(reinterpret_cast<char*>(path.buf), path.size));
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line == "endData") break;
+        Pose point(0, 0);
+        if (std::sscanf(line.c_str(), "%f, %f, %f", &point.x, &point.y, &point.theta) != 3) break;
+        points.push_back(point);
+    }
+    return points;
+}
+
+int findClosest(Pose pose, const std::vector<Pose>& path) {
+    int closest = 0;
+    float closestDist = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < path.size(); i++) {
+        const float dist = pose.distance(path[i]);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+// Fraction along p1-p2 where it leaves the lookahead circle around `pose`, or -1
+float circleIntersect(Pose p1, Pose p2, Pose pose, float lookaheadDist) {
+    const Pose d = p2 - p1;
+    const Pose f = p1 - pose;
+    const float a = d * d;
+    const float b = 2 * (f * d);
+    const float c = f * f - lookaheadDist * lookaheadDist;
+    float discriminant = b * b - 4 * a * c;
+    if (discriminant >= 0) {
+        discriminant = std::sqrt(discriminant);
+        const float t1 = (-b - discriminant) / (2 * a);
+        const float t2 = (-b + discriminant) / (2 * a);
+        // Prefer the intersection further along the path
+        if (t2 >= 0 && t2 <= 1) return t2;
+        if (t1 >= 0 && t1 <= 1) return t1;
+    }
+    return -1;
+}
+
+// The lookahead point never moves backwards along the path; its segment index is kept in theta
+Pose lookaheadPoint(Pose lastLookahead, Pose pose, const std::vector<Pose>& path, int closest, float lookaheadDist) {
+    const int start = std::max(closest, int(lastLookahead.theta));
+    for (int i = start; i < int(path.size()) - 1; i++) {
+        const float t = circleIntersect(path[i], path[i + 1], pose, lookaheadDist);
+        if (t != -1) {
+            Pose lookahead = path[i].lerp(path[i + 1], t);
+            lookahead.theta = i;
+            return lookahead;
+        }
+    }
+    return lastLookahead; // Off the path: keep aiming at the last point
+}
+
+} // namespace
+
+void Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    if (claimChassis(*this, async, [=, this] { follow(path, lookahead, timeout, forwards, false); })) return;
+    const std::vector<Pose> pathPoints = getData(path);
+    if (pathPoints.empty()) {
+        distTraveled = -1;
+        endMotion();
+        return;
+    }
+    Pose lastPose = getPose(true);
+    Pose lastLookahead = pathPoints[0];
+    lastLookahead.theta = 0;
+    const uint8_t compState = pros::competition::get_status();
+    distTraveled = 0;
+
+    for (int i = 0; i < timeout / 10 && pros::competition::get_status() == compState && motionRunning; i++) {
+        Pose pose = getPose(true);
+        if (!forwards) pose.theta -= M_PI;
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // The path ends where its speed drops to 0
+        const int closest = findClosest(pose, pathPoints);
+        if (pathPoints[closest].theta == 0) break;
+
+        const Pose lookaheadPose = lookaheadPoint(lastLookahead, pose, pathPoints, closest, lookahead);
+        lastLookahead = lookaheadPose;
+        const float curvature = getCurvature(Pose(pose.x, pose.y, M_PI_2 - pose.theta), lookaheadPose);
+
+        const float targetVel = pathPoints[closest].theta;
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+        const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+        if (forwards) {
+            drivetrain.leftMotors->move(targetLeftVel);
+            drivetrain.rightMotors->move(targetRightVel);
+        } else {
+            drivetrain.leftMotors->move(-targetRightVel);
+            drivetrain.rightMotors->move(-targetLeftVel);
+        }
+        pros::delay(10);
+    }
+    finishMotion(*this);
+}
+
+} // namespace lemlib
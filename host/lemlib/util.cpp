@@ -0,0 +1,45 @@
+#include "lemlib/util.hpp"
+#include <numeric>
+
+namespace lemlib {
+
+float slew(float target, float current, float maxChange) {
+    if (maxChange == 0) return target;
+    return current + std::clamp(target - current, -maxChange, maxChange);
+}
+
+constexpr float sanitizeAngle(float angle, bool radians) {
+    const float max = radians ? 2 * M_PI : 360;
+    return std::fmod(std::fmod(angle, max) + max, max);
+}
+
+float angleError(float target, float position, bool radians, AngularDirection direction) {
+    target = sanitizeAngle(target, radians);
+    position = sanitizeAngle(position, radians);
+    const float max = radians ? 2 * M_PI : 360;
+    const float rawError = target - position;
+    switch (direction) {
+        case AngularDirection::CW_CLOCKWISE: return rawError < 0 ? rawError + max : rawError;
+        case AngularDirection::CCW_COUNTERCLOCKWISE: return rawError > 0 ? rawError - max : rawError;
+        default: return std::remainder(rawError, max);
+    }
+}
+
+float avg(std::vector<float> values) {
+    if (values.empty()) return 0;
+    return std::accumulate(values.begin(), values.end(), 0.0f) / values.size();
+}
+
+float ema(float current, float previous, float smooth) { return current * smooth + previous * (1 - smooth); }
+
+// Signed curvature of the arc from `pose` (standard heading) through `other`
+float getCurvature(Pose pose, Pose other) {
+    const float side = sgn(std::sin(pose.theta) * (other.x - pose.x) - std::cos(pose.theta) * (other.y - pose.y));
+    const float a = -std::tan(pose.theta);
+    const float c = std::tan(pose.theta) * pose.x - pose.y;
+    const float x = std::fabs(a * other.x + other.y + c) / std::sqrt(a * a + 1);
+    const float d = std::hypot(other.x - pose.x, other.y - pose.y);
+    return side * (2 * x / (d * d));
+}
+
+} // namespace lemlib
@@ -0,0 +1,369 @@
+// Monte Carlo robustness runner for the autons: runs robot_host (robot_host.cpp) many times per auton with a random
+// placement error, sensor noise, battery voltage and traction, spread over every core, and reports how often each auton
+// ends where its nominal run does. A run's conditions depend only on (seed, auton, run number), so a seed reproduces
+// the same report on any machine with any number of jobs.
+//
+// Usage: monte_carlo [--auton N|all] [--runs N] [--seed N] [--jobs N] [--blue] [--tolerance IN]
+//                    [--heading-tolerance DEG] [--csv FILE] [--host PATH]
+//   --auton      auton to test (default: all of them)
+//   --jobs       parallel robot_host processes (default: one per core)
+//   --tolerance  a run succeeds when autonomous completed in time and the robot's true end pose is within these of
+//                the nominal run's (no placement error or sensor noise, PhysicsConfig battery and traction)
+//   --csv        also writes every run's conditions and outcome
+//   --host       robot_host binary (default: next to this one)
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <spawn.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define DEFAULT_RUNS 1000
+#define DEFAULT_TOLERANCE 3         // Inches from the nominal end position
+#define DEFAULT_HEADING_TOLERANCE 5 // Degrees from the nominal end heading
+
+// Conditions drawn for every run
+#define START_ERROR_XY 0.5          // Inches (1 sigma) of placement error along each axis
+#define START_ERROR_THETA 1.0       // Degrees (1 sigma)
+#define NOISE_SCALE_MIN 0.5         // Multiples of the default sensor noise (PhysicsConfig)
+#define NOISE_SCALE_MAX 2.0
+#define BATTERY_MIN 11.8            // Open-circuit volts, from a tired battery to a fresh one
+#define BATTERY_MAX 12.9
+#define TRACTION_MIN 0.8            // Multiples of the default tread friction: dusty to fresh tiles
+#define TRACTION_MAX 1.1
+
+extern char** environ;
+
+namespace {
+
+// --- Work Stealing Pool ---
+// Each worker owns a deque of job indices, works from its front and, once it runs dry, steals from the back of the
+// others', so a worker stuck with slow runs doesn't hold up the rest.
+class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(int workers) : queues(workers) {}
+
+        // Calls job(i) once for every i in [0, jobs), returning when all have finished
+        void run(size_t jobs, const std::function<void(size_t)>& job) {
+            size_t workers = queues.size();
+            for (size_t w = 0; w < workers; w++) {
+                for (size_t i = jobs * w / workers; i < jobs * (w + 1) / workers; i++) queues[w].jobs.push_back(i);
+            }
+            std::vector<std::thread> threads;
+            for (size_t w = 0; w < workers; w++) {
+                threads.emplace_back([this, w, &job] {
+                    size_t index;
+                    while (take(w, index)) job(index);
+                });
+            }
+            for (std::thread& thread : threads) thread.join();
+        }
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<size_t> jobs;
+        };
+
+        bool take(size_t worker, size_t& index) {
+            for (size_t i = 0; i < queues.size(); i++) {
+                bool own = i == 0;
+                Queue& queue = queues[(worker + i) % queues.size()];
+                std::lock_guard lock(queue.mutex);
+                if (queue.jobs.empty()) continue;
+                index = own ? queue.jobs.front() : queue.jobs.back();
+                if (own) queue.jobs.pop_front();
+                else queue.jobs.pop_back();
+                return true;
+            }
+            return false; // Nothing is ever added while running, so every queue is done
+        }
+
+        std::vector<Queue> queues;
+};
+
+// --- Runs ---
+struct Conditions {
+    double startX, startY, startTheta; // Placement error
+    double noise, battery, traction;
+    uint64_t seed;                     // Sensor noise seed
+};
+
+struct Outcome {
+    bool ran = false; // robot_host printed a RESULT line
+    bool completed = false;
+    unsigned timeMs = 0;
+    double x = 0, y = 0, theta = 0; // True end pose, auton coordinates
+};
+
+Conditions drawConditions(uint64_t seed, int auton, size_t run) {
+    std::seed_seq sequence {uint32_t(seed), uint32_t(seed >> 32), uint32_t(auton), uint32_t(run), uint32_t(run >> 32)};
+    std::mt19937_64 random(sequence);
+    std::normal_distribution<double> normal;
+    auto uniform = [&](double min, double max) { return std::uniform_real_distribution<double>(min, max)(random); };
+    Conditions conditions;
+    conditions.startX = normal(random) * START_ERROR_XY;
+    conditions.startY = normal(random) * START_ERROR_XY;
+    conditions.startTheta = normal(random) * START_ERROR_THETA;
+    conditions.noise = uniform(NOISE_SCALE_MIN, NOISE_SCALE_MAX);
+    conditions.battery = uniform(BATTERY_MIN, BATTERY_MAX);
+    conditions.traction = uniform(TRACTION_MIN, TRACTION_MAX);
+    conditions.seed = random();
+    return conditions;
+}
+
+// Runs the binary with `args` and returns everything it wrote to stderr (empty if it couldn't start)
+std::string runProcess(const std::string& path, const std::vector<std::string>& args) {
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) return "";
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDERR_FILENO);
+    std::vector<char*> argv {const_cast<char*>(path.c_str())};
+    for (const std::string& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    pid_t pid;
+    int error = posix_spawn(&pid, path.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipeFds[1]);
+    std::string output;
+    if (error == 0) {
+        char buffer[512];
+        ssize_t count;
+        while ((count = read(pipeFds[0], buffer, sizeof(buffer))) > 0) output.append(buffer, count);
+        waitpid(pid, nullptr, 0);
+    }
+    close(pipeFds[0]);
+    return output;
+}
+
+Outcome parseOutcome(const std::string& output) {
+    Outcome outcome;
+    size_t line = output.find("RESULT ");
+    if (line == std::string::npos) return outcome;
+    int completed;
+    if (std::sscanf(output.c_str() + line, "RESULT auton=%*d alliance=%*s completed=%d time_ms=%u x=%lf y=%lf theta=%lf",
+                    &completed, &outcome.timeMs, &outcome.x, &outcome.y, &outcome.theta) == 5) {
+        outcome.ran = true;
+        outcome.completed = completed != 0;
+    }
+    return outcome;
+}
+
+std::string format(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.4f", value);
+    return text;
+}
+
+struct Options {
+    std::vector<int> autons; // Empty for all
+    size_t runs = DEFAULT_RUNS;
+    uint64_t seed = 0;
+    int jobs = 0;
+    bool blue = false;
+    double tolerance = DEFAULT_TOLERANCE;
+    double headingTolerance = DEFAULT_HEADING_TOLERANCE;
+    const char* csv = nullptr;
+    std::string host;
+};
+
+// Arguments shared by every run of an auton
+std::vector<std::string> baseArgs(const Options& options, int auton) {
+    std::vector<std::string> args {"--auton", std::to_string(auton)};
+    if (options.blue) args.push_back("--blue");
+    return args;
+}
+
+Outcome runNominal(const Options& options, int auton) {
+    std::vector<std::string> args = baseArgs(options, auton);
+    args.insert(args.end(), {"--noise", "0"});
+    return parseOutcome(runProcess(options.host, args));
+}
+
+Outcome runOnce(const Options& options, int auton, const Conditions& conditions) {
+    std::vector<std::string> args = baseArgs(options, auton);
+    args.insert(args.end(), {"--start-error",
+                             format(conditions.startX) + "," + format(conditions.startY) + "," +
+                                 format(conditions.startTheta),
+                             "--noise", format(conditions.noise), "--battery", format(conditions.battery),
+                             "--traction", format(conditions.traction), "--seed", std::to_string(conditions.seed)});
+    return parseOutcome(runProcess(options.host, args));
+}
+
+// --- Report ---
+double positionError(const Outcome& outcome, const Outcome& nominal) {
+    return std::hypot(outcome.x - nominal.x, outcome.y - nominal.y);
+}
+
+double headingError(const Outcome& outcome, const Outcome& nominal) {
+    return std::abs(std::remainder(outcome.theta - nominal.theta, 360.0));
+}
+
+// Nearest-rank percentile of sorted values
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return NAN;
+    size_t rank = static_cast<size_t>(std::ceil(p / 100 * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void printDistribution(const char* label, std::vector<double> values, const char* unit) {
+    std::sort(values.begin(), values.end());
+    std::printf("  %-15s p50 %8.1f  p90 %8.1f  p99 %8.1f  max %8.1f %s\n", label, percentile(values, 50),
+                percentile(values, 90), percentile(values, 99), values.empty() ? NAN : values.back(), unit);
+}
+
+void report(const Options& options, int auton, const std::string& name, const Outcome& nominal,
+            const std::vector<Outcome>& outcomes) {
+    size_t crashed = 0, timedOut = 0, offTarget = 0;
+    std::vector<double> position, heading, time;
+    for (const Outcome& outcome : outcomes) {
+        if (!outcome.ran) {
+            crashed++;
+            continue;
+        }
+        position.push_back(positionError(outcome, nominal));
+        heading.push_back(headingError(outcome, nominal));
+        if (!outcome.completed) timedOut++;
+        else {
+            time.push_back(outcome.timeMs);
+            if (position.back() > options.tolerance || heading.back() > options.headingTolerance) offTarget++;
+        }
+    }
+    size_t successes = outcomes.size() - crashed - timedOut - offTarget;
+    std::printf("auton %d %s (%s): %zu runs, seed %llu\n", auton, name.c_str(), options.blue ? "blue" : "red",
+                outcomes.size(), static_cast<unsigned long long>(options.seed));
+    std::printf("  nominal         completed=%d time %u ms, ends at (%.2f, %.2f, %.2f)\n", nominal.completed,
+                nominal.timeMs, nominal.x, nominal.y, nominal.theta);
+    std::printf("  success         %.1f%% (%zu); timed out %zu, off target %zu, crashed %zu\n",
+                100.0 * successes / outcomes.size(), successes, timedOut, offTarget, crashed);
+    printDistribution("end error", position, "in");
+    printDistribution("heading error", heading, "deg");
+    printDistribution("completion time", time, "ms");
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--blue") == 0) {
+            options.blue = true;
+            continue;
+        }
+        if (value == nullptr) return false;
+        i++;
+        if (std::strcmp(arg, "--auton") == 0) {
+            if (std::strcmp(value, "all") == 0) options.autons.clear();
+            else options.autons.push_back(std::atoi(value));
+        } else if (std::strcmp(arg, "--runs") == 0) options.runs = std::strtoull(value, nullptr, 0);
+        else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoull(value, nullptr, 0);
+        else if (std::strcmp(arg, "--jobs") == 0) options.jobs = std::atoi(value);
+        else if (std::strcmp(arg, "--tolerance") == 0) options.tolerance = std::atof(value);
+        else if (std::strcmp(arg, "--heading-tolerance") == 0) options.headingTolerance = std::atof(value);
+        else if (std::strcmp(arg, "--csv") == 0) options.csv = value;
+        else if (std::strcmp(arg, "--host") == 0) options.host = value;
+        else return false;
+    }
+    return options.runs > 0;
+}
+
+// Auton numbers and names from robot_host --list
+std::vector<std::pair<int, std::string>> listAutons(const std::string& host) {
+    std::vector<std::pair<int, std::string>> autons;
+    std::string output = runProcess(host, {"--list"});
+    size_t start = 0;
+    while (start < output.size()) {
+        size_t end = output.find('\n', start);
+        if (end == std::string::npos) end = output.size();
+        int number, length;
+        if (std::sscanf(output.c_str() + start, "AUTON %d %n", &number, &length) == 1) {
+            autons.emplace_back(number, output.substr(start + length, end - start - length));
+        }
+        start = end + 1;
+    }
+    return autons;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--auton N|all] [--runs N] [--seed N] [--jobs N] [--blue] [--tolerance IN] "
+                             "[--heading-tolerance DEG] [--csv FILE] [--host PATH]\n", argv[0]);
+        return 2;
+    }
+    if (options.host.empty()) {
+        std::string self = argv[0];
+        size_t slash = self.rfind('/');
+        options.host = (slash == std::string::npos ? std::string("./") : self.substr(0, slash + 1)) + "robot_host";
+    }
+    if (options.jobs <= 0) options.jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::pair<int, std::string>> available = listAutons(options.host);
+    if (available.empty()) {
+        std::fprintf(stderr, "monte_carlo: could not list the autons with %s\n", options.host.c_str());
+        return 1;
+    }
+    std::vector<std::pair<int, std::string>> autons;
+    for (const auto& auton : available) {
+        if (options.autons.empty() || std::ranges::count(options.autons, auton.first) > 0) autons.push_back(auton);
+    }
+    if (autons.size() != (options.autons.empty() ? available.size() : options.autons.size())) {
+        std::fprintf(stderr, "monte_carlo: no such auton (there are %zu)\n", available.size());
+        return 2;
+    }
+
+    // Every run of every auton goes through one pool, so the cores stay busy across auton boundaries
+    WorkStealingPool pool(options.jobs);
+    std::vector<Outcome> nominal(autons.size());
+    pool.run(autons.size(), [&](size_t i) { nominal[i] = runNominal(options, autons[i].first); });
+    std::vector<Conditions> conditions(autons.size() * options.runs);
+    std::vector<Outcome> outcomes(conditions.size());
+    std::atomic<size_t> finished = 0;
+    pool.run(conditions.size(), [&](size_t job) {
+        int auton = autons[job / options.runs].first;
+        conditions[job] = drawConditions(options.seed, auton, job % options.runs);
+        outcomes[job] = runOnce(options, auton, conditions[job]);
+        size_t done = ++finished;
+        if (done % 100 == 0 || done == conditions.size()) std::fprintf(stderr, "\r%zu/%zu runs", done, conditions.size());
+    });
+    std::fprintf(stderr, "\n");
+
+    for (size_t i = 0; i < autons.size(); i++) {
+        auto first = outcomes.begin() + i * options.runs;
+        report(options, autons[i].first, autons[i].second, nominal[i],
+               std::vector<Outcome>(first, first + options.runs));
+    }
+
+    if (options.csv != nullptr) {
+        FILE* csv = std::fopen(options.csv, "w");
+        if (csv == nullptr) {
+            std::perror(options.csv);
+            return 1;
+        }
+        std::fprintf(csv, "auton,run,start_x,start_y,start_theta,noise,battery,traction,seed,ran,completed,time_ms,"
+                          "x,y,theta,end_error,heading_error\n");
+        for (size_t job = 0; job < outcomes.size(); job++) {
+            const Conditions& c = conditions[job];
+            const Outcome& o = outcomes[job];
+            const Outcome& n = nominal[job / options.runs];
+            std::fprintf(csv, "%d,%zu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%llu,%d,%d,%u,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                         autons[job / options.runs].first, job % options.runs, c.startX, c.startY, c.startTheta,
+                         c.noise, c.battery, c.traction, static_cast<unsigned long long>(c.seed), o.ran, o.completed,
+                         o.timeMs, o.x, o.y, o.theta, positionError(o, n), headingError(o, n));
+        }
+        std::fclose(csv);
+    }
+    return 0;
+}
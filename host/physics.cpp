@@ -0,0 +1,149 @@
+#include "physics.hpp"
+#include "brain.hpp"
+#include "robot_config.hpp"
+#include <algorithm>
+
+#define SUBSTEPS 10        // Per 1 ms step; the tread contact settles in well under a millisecond
+#define GRAVITY 9.81
+#define INCH 0.0254        // m
+
+// V5 firmware control loops, in volts per unit of error
+#define VELOCITY_GAIN 0.3  // Per rad/s
+#define POSITION_GAIN 10   // rad/s of target speed per rad of position error
+
+namespace host {
+
+namespace {
+
+constexpr int LEFT_PORTS[] = {PORT_LEFT_MOTOR_1, PORT_LEFT_MOTOR_2, PORT_LEFT_MOTOR_3};
+constexpr int RIGHT_PORTS[] = {PORT_RIGHT_MOTOR_1, PORT_RIGHT_MOTOR_2, PORT_RIGHT_MOTOR_3};
+
+constexpr double WHEEL_RADIUS = WHEEL_DIAMETER / 2 * INCH;
+constexpr double HALF_TRACK = TRACK_WIDTH / 2 * INCH;
+constexpr double RAD_PER_DEG = M_PI / 180;
+constexpr double RPM_PER_RAD_S = 30 / M_PI;
+
+int direction(int port) { return port < 0 ? -1 : 1; }
+
+// Motor output shaft speed per wheel speed (the external gearing)
+double gearing(const MotorPort& motor) { return motor.maxRpm() / WHEEL_RPM; }
+
+// Friction that saturates smoothly at `limit` once `speed` passes `scale`
+double saturate(double speed, double scale, double limit) { return limit * std::tanh(speed / scale); }
+
+} // namespace
+
+PhysicsWorld::PhysicsWorld(const FieldPose& start, const PhysicsConfig& config)
+    : config(config), robot(start), sensors(config.noise, config.seed), left {LEFT_PORTS, 1},
+      right {RIGHT_PORTS, -1}, batteryVoltage(config.batteryVoltage) {
+    sensors.write(robot, 0, 0, 0, 0);
+}
+
+void PhysicsWorld::step(uint32_t now) {
+    // Always whole milliseconds; catch up if the kernel ever skipped a tick
+    while (lastStep != now) {
+        for (int i = 0; i < SUBSTEPS; i++) substep(0.001 / SUBSTEPS);
+        lastStep++;
+        sensors.write(robot, forward / INCH, lateral / INCH, omega / RAD_PER_DEG, 0.001);
+    }
+    brain.batteryVoltage = static_cast<int32_t>(batteryVoltage * 1000);
+    brain.batteryCurrent = static_cast<int32_t>(batteryCurrent * 1000);
+}
+
+double PhysicsWorld::motorForce(Side& side, double& current) {
+    double wheelSpeed = side.treadSpeed / WHEEL_RADIUS; // rad/s
+    double torque = 0;                                   // Nm at the wheel
+    for (int i = 0; i < 3; i++) {
+        int port = side.ports[i];
+        int dir = direction(port);
+        MotorPort& motor = brain.port(port)->motor;
+        double ratio = gearing(motor);
+        double speed = dir * wheelSpeed * ratio; // rad/s of the output shaft, in the motor's own direction
+        double maxSpeed = motor.maxRpm() / RPM_PER_RAD_S;
+        double limit = std::min(motor.currentLimit / 1000.0, 2.5);
+
+        // What the firmware does with the command
+        bool hold = motor.stopping() && motor.brakeMode == pros::E_MOTOR_BRAKE_HOLD;
+        if (hold && !side.holding[i]) side.holdPosition[i] = motor.position;
+        side.holding[i] = hold;
+        bool open = motor.stopping() && motor.brakeMode == pros::E_MOTOR_BRAKE_COAST;
+        double voltage = 0;
+        double targetSpeed = NAN;
+        if (hold) {
+            targetSpeed = std::clamp((side.holdPosition[i] - motor.position) * RAD_PER_DEG * POSITION_GAIN, -maxSpeed,
+                                     maxSpeed);
+        } else if (motor.stopping()) {
+            voltage = 0; // Brake shorts the windings; coast leaves them open
+        } else if (motor.mode == MotorMode::VOLTAGE) {
+            voltage = motor.commandedVoltage() / 1000.0;
+        } else if (motor.mode == MotorMode::VELOCITY) {
+            targetSpeed = motor.targetVelocity / RPM_PER_RAD_S;
+        } else if (motor.mode == MotorMode::POSITION) {
+            double cap = std::abs(motor.targetVelocity) / RPM_PER_RAD_S;
+            targetSpeed = std::clamp((motor.targetPosition - motor.position) * RAD_PER_DEG * POSITION_GAIN, -cap, cap);
+        }
+        if (!std::isnan(targetSpeed)) {
+            voltage = config.backEmf * targetSpeed + VELOCITY_GAIN * (targetSpeed - speed);
+        }
+        if (motor.voltageLimit > 0) voltage = std::clamp(voltage, -motor.voltageLimit / 1000.0, motor.voltageLimit / 1000.0);
+        voltage = std::clamp(voltage, -batteryVoltage, batteryVoltage);
+
+        // DC motor: the winding current is what the applied voltage drives against the back-EMF
+        double amps = open ? 0 : std::clamp((voltage - config.backEmf * speed) / config.resistance, -limit, limit);
+        double shaftTorque = config.backEmf * amps - saturate(speed, 0.5, config.friction);
+        torque += dir * shaftTorque * ratio;
+        current += std::abs(amps);
+
+        motor.velocity = speed * RPM_PER_RAD_S;
+        motor.voltage = static_cast<int32_t>((open ? config.backEmf * speed : voltage) * 1000);
+        motor.current = static_cast<int32_t>(std::abs(amps) * 1000);
+        motor.torque = shaftTorque;
+    }
+    return torque / WHEEL_RADIUS;
+}
+
+void PhysicsWorld::substep(double dt) {
+    const double weight = config.mass * GRAVITY;
+    double current = 0;
+    double force[2];
+    double tread[2];
+    Side* sides[2] = {&left, &right};
+    for (int i = 0; i < 2; i++) {
+        Side& side = *sides[i];
+        // The tread pushes the robot only as hard as it grips: slip saturates the friction
+        double groundSpeed = forward + side.sign * omega * HALF_TRACK;
+        double grip = config.traction * weight / 2;
+        tread[i] = saturate(side.treadSpeed - groundSpeed, config.slipSpeed, grip);
+        force[i] = motorForce(side, current);
+    }
+    for (int i = 0; i < 2; i++) sides[i]->treadSpeed += (force[i] - tread[i]) / config.sideInertia * dt;
+
+    // Body, in the robot frame (forward, leftward, clockwise); the frame turns under the velocity
+    double rolling = config.rollingResistance * weight;
+    double forwardForce = tread[0] + tread[1] - saturate(forward, 0.01, rolling);
+    double lateralForce = -saturate(lateral, config.slipSpeed, config.lateralTraction * weight);
+    double turnTorque = (tread[0] - tread[1]) * HALF_TRACK - saturate(omega, 0.05, rolling * HALF_TRACK);
+    double forwardAccel = forwardForce / config.mass - omega * lateral;
+    double lateralAccel = lateralForce / config.mass + omega * forward;
+    forward += forwardAccel * dt;
+    lateral += lateralAccel * dt;
+    omega += turnTorque / config.inertia * dt;
+
+    double heading = robot.theta * RAD_PER_DEG;
+    robot.x += (forward * std::sin(heading) - lateral * std::cos(heading)) * dt / INCH;
+    robot.y += (forward * std::cos(heading) + lateral * std::sin(heading)) * dt / INCH;
+    robot.theta += omega * dt / RAD_PER_DEG;
+
+    // Motor encoders follow their wheels
+    for (Side* side : sides) {
+        for (int i = 0; i < 3; i++) {
+            MotorPort& motor = brain.port(side->ports[i])->motor;
+            motor.position += motor.velocity * 6 * dt;
+        }
+    }
+    // The battery sags under load
+    batteryCurrent = current;
+    batteryVoltage = config.batteryVoltage - config.batteryResistance * current;
+}
+
+} // namespace host
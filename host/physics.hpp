@@ -0,0 +1,79 @@
+#ifndef HOST_PHYSICS_HPP
+#define HOST_PHYSICS_HPP
+
+#include "world.hpp"
+#include <cmath>
+
+// --- Physics World ---
+// Rigid-body differential drive matched to the robot in robot_config.hpp: three motors per side geared to
+// WHEEL_RPM on WHEEL_DIAMETER wheels TRACK_WIDTH apart. Each motor is a DC motor (applied voltage against back-EMF
+// through the winding resistance, under the firmware's current limit) with the V5 firmware's velocity, position and
+// brake behaviour on top. The wheels push the robot through tread friction that saturates, so hard acceleration
+// spins the wheels and fast turns slide sideways. Integrated at 1 kHz (one step per kernel tick) with smaller
+// substeps for the stiff tire contact.
+// Robot-specific numbers live in PhysicsConfig; the defaults are estimates for a 15 lb six-motor drive on foam
+// tiles, so weigh and measure the real robot before trusting absolute times.
+
+namespace host {
+
+struct PhysicsConfig {
+    // Robot
+    double mass = 6.8;                // kg
+    double inertia = 0.15;            // kg m^2 about the tracking center
+    double sideInertia = 0.4;         // kg; rotating parts of one side (wheels, gears, rotors) as mass at the tread
+    // Tread contact
+    double traction = 1.0;            // Forward friction coefficient of the drive wheels
+    double lateralTraction = 0.8;     // Sideways friction coefficient (omni rollers, traction wheels)
+    double slipSpeed = 0.05;          // m/s of slip at which friction saturates
+    double rollingResistance = 0.015; // Fraction of the weight resisting motion
+    // Motor (per motor, at the cartridge output)
+    double backEmf = 12 / (600 * M_PI / 30); // V per rad/s (a blue cartridge spins 600 rpm at 12 V)
+    double resistance = 3.84;         // Ohm
+    double friction = 0.01;           // Nm of internal friction
+    // Battery
+    double batteryVoltage = 12.8;     // V open circuit
+    double batteryResistance = 0.05;  // Ohm
+    // Sensors
+    SensorNoise noise {
+        .rotation = 0.05,
+        .gyroNoise = 0.1,
+        .gyroBias = 0.005,
+        .gyroScale = 0.002,
+        .distanceFraction = 0.015,
+        .distanceMinimum = 5,
+    };
+    uint64_t seed = 0;                // Seeds the sensor noise
+};
+
+class PhysicsWorld : public World {
+    public:
+        PhysicsWorld(const FieldPose& start, const PhysicsConfig& config = {});
+        void step(uint32_t now) override;
+        FieldPose pose() const override { return robot; }
+    private:
+        struct Side {
+            const int* ports;           // Three motor ports, signed like robot_config.hpp
+            double sign;                // +1 for the left side (a clockwise turn moves it forward), -1 for the right
+            double treadSpeed = 0;      // m/s of the wheel surface, forward positive
+            bool holding[3] = {};       // Stopped in HOLD...
+            double holdPosition[3] = {}; // ...at this raw position (degrees)
+        };
+
+        void substep(double dt);
+        // Force (N, forward) the side's motors put on its tread; adds their current draw (A) to `current`
+        double motorForce(Side& side, double& current);
+
+        PhysicsConfig config;
+        FieldPose robot;
+        SensorModel sensors;
+        Side left, right;
+        double forward = 0, lateral = 0; // m/s in the robot frame (lateral: leftward)
+        double omega = 0;                // rad/s clockwise
+        double batteryVoltage;           // V at the terminals, after sag
+        double batteryCurrent = 0;       // A drawn by the motors
+        uint32_t lastStep = 0;
+};
+
+} // namespace host
+
+#endif
@@ -0,0 +1,842 @@
+// Smart port devices of the PROS API, backed by the host brain (brain.hpp)
+#include "brain.hpp"
+#include "kernel.hpp"
+#include "pros/device.hpp"
+#include "pros/distance.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+using host::brain;
+
+namespace {
+
+// The device on `port` when it has the expected type; sets errno like PROS otherwise
+host::SmartPort* deviceOn(int port, pros::c::v5_device_e_t type) {
+    host::SmartPort* slot = brain.port(port);
+    if (slot == nullptr) {
+        errno = ENXIO;
+        return nullptr;
+    }
+    if (slot->type != type) {
+        errno = ENODEV;
+        return nullptr;
+    }
+    return slot;
+}
+
+double wrap360(double degrees) {
+    degrees = std::fmod(degrees, 360);
+    return degrees < 0 ? degrees + 360 : degrees;
+}
+
+double wrap180(double degrees) {
+    degrees = wrap360(degrees);
+    return degrees > 180 ? degrees - 360 : degrees;
+}
+
+} // namespace
+
+// --- Device ---
+pros::c::v5_device_e_t pros::c::get_plugged_type(uint8_t port) {
+    host::SmartPort* slot = brain.port(port);
+    return slot != nullptr ? slot->type : E_DEVICE_UNDEFINED;
+}
+
+namespace pros {
+inline namespace v5 {
+
+Device::Device(const std::uint8_t port) : _port(port) {}
+
+std::uint8_t Device::get_port() const { return _port; }
+
+bool Device::is_installed() { return get_plugged_type() == _deviceType; }
+
+DeviceType Device::get_plugged_type() const { return get_plugged_type(_port); }
+
+DeviceType Device::get_plugged_type(std::uint8_t port) {
+    return static_cast<DeviceType>(c::get_plugged_type(port));
+}
+
+std::vector<Device> Device::get_all_devices(DeviceType device_type) {
+    std::vector<Device> found;
+    for (std::uint8_t port = 1; port <= 21; port++) {
+        DeviceType type = get_plugged_type(port);
+        if (type != DeviceType::none && (device_type == DeviceType::undefined || type == device_type)) {
+            found.emplace_back(port);
+        }
+    }
+    return found;
+}
+
+// --- MotorGroup ---
+// Reversed ports (negative numbers) flip every command and measurement, as on the brain
+namespace {
+
+host::MotorPort* motorOn(std::int8_t port) {
+    host::SmartPort* slot = deviceOn(port, c::E_DEVICE_MOTOR);
+    return slot != nullptr ? &slot->motor : nullptr;
+}
+
+int direction(std::int8_t port) { return port < 0 ? -1 : 1; }
+
+constexpr double NO_VALUE = PROS_ERR_F;
+
+double countsPerRev(const host::MotorPort& motor) {
+    switch (motor.gearset) {
+        case E_MOTOR_GEAR_RED: return 1800;
+        case E_MOTOR_GEAR_BLUE: return 300;
+        default: return 900;
+    }
+}
+
+double toUnits(const host::MotorPort& motor, double degrees) {
+    switch (motor.units) {
+        case E_MOTOR_ENCODER_ROTATIONS: return degrees / 360;
+        case E_MOTOR_ENCODER_COUNTS: return degrees / 360 * countsPerRev(motor);
+        default: return degrees;
+    }
+}
+
+double fromUnits(const host::MotorPort& motor, double value) {
+    switch (motor.units) {
+        case E_MOTOR_ENCODER_ROTATIONS: return value * 360;
+        case E_MOTOR_ENCODER_COUNTS: return value * 360 / countsPerRev(motor);
+        default: return value;
+    }
+}
+
+// Reads one motor of the group; `read` gets the motor and the port's direction
+template <typename T, typename F>
+T readMotor(const std::vector<std::int8_t>& ports, std::uint8_t index, T error, F read) {
+    if (index >= ports.size()) {
+        errno = EOVERFLOW;
+        return error;
+    }
+    host::MotorPort* motor = motorOn(ports[index]);
+    return motor != nullptr ? read(*motor, direction(ports[index])) : error;
+}
+
+template <typename T, typename F>
+std::vector<T> readMotors(const std::vector<std::int8_t>& ports, T error, F read) {
+    std::vector<T> values;
+    for (std::uint8_t i = 0; i < ports.size(); i++) values.push_back(readMotor(ports, i, error, read));
+    return values;
+}
+
+// Applies `write` to one motor (or all of them when `index` is -1)
+template <typename F>
+std::int32_t writeMotors(const std::vector<std::int8_t>& ports, int index, F write) {
+    if (index >= static_cast<int>(ports.size())) {
+        errno = EOVERFLOW;
+        return PROS_ERR;
+    }
+    std::int32_t result = PROS_SUCCESS;
+    for (int i = 0; i < static_cast<int>(ports.size()); i++) {
+        if (index >= 0 && i != index) continue;
+        host::MotorPort* motor = motorOn(ports[i]);
+        if (motor == nullptr) {
+            result = PROS_ERR;
+            continue;
+        }
+        write(*motor, direction(ports[i]));
+    }
+    return result;
+}
+
+} // namespace
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset,
+                       const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset,
+                       const MotorUnits encoder_units)
+    : _ports(ports) {
+    if (gearset != MotorGears::invalid) set_gearing_all(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units_all(encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group) : _ports(motor_group.get_port_all()) {}
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+    voltage = std::clamp(voltage, -127, 127);
+    return move_voltage(voltage * 12000 / 127);
+}
+
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int dir) {
+        motor.mode = host::MotorMode::POSITION;
+        motor.targetPosition = motor.zero + dir * fromUnits(motor, position);
+        motor.targetVelocity = std::abs(velocity);
+    });
+}
+
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int dir) {
+        double base = motor.mode == host::MotorMode::POSITION ? motor.targetPosition : motor.position;
+        motor.mode = host::MotorMode::POSITION;
+        motor.targetPosition = base + dir * fromUnits(motor, position);
+        motor.targetVelocity = std::abs(velocity);
+    });
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int dir) {
+        motor.mode = host::MotorMode::VELOCITY;
+        motor.targetVelocity = dir * velocity;
+    });
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int dir) {
+        motor.mode = host::MotorMode::VOLTAGE;
+        motor.targetVoltage = dir * std::clamp(voltage, -12000, 12000);
+    });
+}
+
+std::int32_t MotorGroup::brake() const {
+    return writeMotors(_ports, -1, [](host::MotorPort& motor, int) { motor.mode = host::MotorMode::BRAKE; });
+}
+
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int dir) {
+        if (motor.mode == host::MotorMode::POSITION) motor.targetVelocity = std::abs(velocity);
+        else if (motor.mode == host::MotorMode::VELOCITY) motor.targetVelocity = dir * velocity;
+    });
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+    return readMotor(_ports, index, NO_VALUE, [](const host::MotorPort& motor, int dir) {
+        return toUnits(motor, dir * (motor.targetPosition - motor.zero));
+    });
+}
+
+std::vector<double> MotorGroup::get_target_position_all() const {
+    return readMotors(_ports, NO_VALUE, [](const host::MotorPort& motor, int dir) {
+        return toUnits(motor, dir * (motor.targetPosition - motor.zero));
+    });
+}
+
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR,
+                     [](const host::MotorPort& motor, int dir) { return dir * motor.targetVelocity; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all() const {
+    return readMotors(_ports, PROS_ERR, [](const host::MotorPort& motor, int dir) { return dir * motor.targetVelocity; });
+}
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+    return readMotor(_ports, index, NO_VALUE,
+                     [](const host::MotorPort& motor, int dir) { return dir * motor.velocity; });
+}
+
+std::vector<double> MotorGroup::get_actual_velocity_all() const {
+    return readMotors(_ports, NO_VALUE, [](const host::MotorPort& motor, int dir) { return dir * motor.velocity; });
+}
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR, [](const host::MotorPort& motor, int) { return motor.current; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_draw_all() const {
+    return readMotors(_ports, PROS_ERR, [](const host::MotorPort& motor, int) { return motor.current; });
+}
+
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR,
+                     [](const host::MotorPort& motor, int dir) { return dir * motor.velocity < 0 ? -1 : 1; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_direction_all() const {
+    return readMotors(_ports, PROS_ERR,
+                      [](const host::MotorPort& motor, int dir) { return dir * motor.velocity < 0 ? -1 : 1; });
+}
+
+// Output power over electrical power, in percent
+static double efficiency(const host::MotorPort& motor) {
+    double electrical = std::fabs(motor.voltage / 1000.0 * motor.current / 1000.0);
+    double mechanical = std::fabs(motor.torque * motor.velocity * 2 * M_PI / 60);
+    return electrical > 0 ? std::min(100.0, 100 * mechanical / electrical) : 0;
+}
+
+double MotorGroup::get_efficiency(const std::uint8_t index) const {
+    return readMotor(_ports, index, NO_VALUE, [](const host::MotorPort& motor, int) { return efficiency(motor); });
+}
+
+std::vector<double> MotorGroup::get_efficiency_all() const {
+    return readMotors(_ports, NO_VALUE, [](const host::MotorPort& motor, int) { return efficiency(motor); });
+}
+
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const {
+    return readMotor(_ports, index, static_cast<std::uint32_t>(PROS_ERR), [](const host::MotorPort&, int) { return 0u; });
+}
+
+std::vector<std::uint32_t> MotorGroup::get_faults_all() const {
+    return readMotors(_ports, static_cast<std::uint32_t>(PROS_ERR), [](const host::MotorPort&, int) { return 0u; });
+}
+
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const {
+    return readMotor(_ports, index, static_cast<std::uint32_t>(PROS_ERR), [](const host::MotorPort&, int) { return 0u; });
+}
+
+std::vector<std::uint32_t> MotorGroup::get_flags_all() const {
+    return readMotors(_ports, static_cast<std::uint32_t>(PROS_ERR), [](const host::MotorPort&, int) { return 0u; });
+}
+
+double MotorGroup::get_position(const std::uint8_t index) const {
+    return readMotor(_ports, index, NO_VALUE, [](const host::MotorPort& motor, int dir) {
+        return toUnits(motor, dir * (motor.position - motor.zero));
+    });
+}
+
+std::vector<double> MotorGroup::get_position_all() const {
+    return readMotors(_ports, NO_VALUE, [](const host::MotorPort& motor, int dir) {
+        return toUnits(motor, dir * (motor.position - motor.zero));
+    });
+}
+
+double MotorGroup::get_power(const std::uint8_t index) const {
+    return readMotor(_ports, index, NO_VALUE, [](const host::MotorPort& motor, int) {
+        return std::fabs(motor.voltage / 1000.0 * motor.current / 1000.0);
+    });
+}
+
+std::vector<double> MotorGroup::get_power_all() const {
+    return readMotors(_ports, NO_VALUE, [](const host::MotorPort& motor, int) {
+        return std::fabs(motor.voltage / 1000.0 * motor.current / 1000.0);
+    });
+}
+
+static std::int32_t rawPosition(const host::MotorPort& motor, int dir) {
+    return static_cast<std::int32_t>(std::lround(dir * motor.position / 360 * countsPerRev(motor)));
+}
+
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    if (timestamp != nullptr) *timestamp = host::nowMs();
+    return readMotor(_ports, index, PROS_ERR, rawPosition);
+}
+
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+    if (timestamp != nullptr) *timestamp = host::nowMs();
+    return readMotors(_ports, PROS_ERR, rawPosition);
+}
+
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+    return readMotor(_ports, index, NO_VALUE, [](const host::MotorPort& motor, int) { return motor.temperature; });
+}
+
+std::vector<double> MotorGroup::get_temperature_all() const {
+    return readMotors(_ports, NO_VALUE, [](const host::MotorPort& motor, int) { return motor.temperature; });
+}
+
+double MotorGroup::get_torque(const std::uint8_t index) const {
+    return readMotor(_ports, index, NO_VALUE, [](const host::MotorPort& motor, int dir) { return dir * motor.torque; });
+}
+
+std::vector<double> MotorGroup::get_torque_all() const {
+    return readMotors(_ports, NO_VALUE, [](const host::MotorPort& motor, int dir) { return dir * motor.torque; });
+}
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR, [](const host::MotorPort& motor, int dir) { return dir * motor.voltage; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_all() const {
+    return readMotors(_ports, PROS_ERR, [](const host::MotorPort& motor, int dir) { return dir * motor.voltage; });
+}
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR, [](const host::MotorPort& motor, int) {
+        return static_cast<std::int32_t>(motor.current >= motor.currentLimit);
+    });
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_current_all() const {
+    return readMotors(_ports, PROS_ERR, [](const host::MotorPort& motor, int) {
+        return static_cast<std::int32_t>(motor.current >= motor.currentLimit);
+    });
+}
+
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR, [](const host::MotorPort& motor, int) {
+        return static_cast<std::int32_t>(motor.temperature >= 55);
+    });
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_temp_all() const {
+    return readMotors(_ports, PROS_ERR, [](const host::MotorPort& motor, int) {
+        return static_cast<std::int32_t>(motor.temperature >= 55);
+    });
+}
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+    return readMotor(_ports, index, MotorBrake::invalid,
+                     [](const host::MotorPort& motor, int) { return static_cast<MotorBrake>(motor.brakeMode); });
+}
+
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all() const {
+    return readMotors(_ports, MotorBrake::invalid,
+                      [](const host::MotorPort& motor, int) { return static_cast<MotorBrake>(motor.brakeMode); });
+}
+
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR, [](const host::MotorPort& motor, int) { return motor.currentLimit; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_limit_all() const {
+    return readMotors(_ports, PROS_ERR, [](const host::MotorPort& motor, int) { return motor.currentLimit; });
+}
+
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+    return readMotor(_ports, index, MotorUnits::invalid,
+                     [](const host::MotorPort& motor, int) { return static_cast<MotorUnits>(motor.units); });
+}
+
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all() const {
+    return readMotors(_ports, MotorUnits::invalid,
+                      [](const host::MotorPort& motor, int) { return static_cast<MotorUnits>(motor.units); });
+}
+
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+    return readMotor(_ports, index, MotorGears::invalid,
+                     [](const host::MotorPort& motor, int) { return static_cast<MotorGears>(motor.gearset); });
+}
+
+std::vector<MotorGears> MotorGroup::get_gearing_all() const {
+    return readMotors(_ports, MotorGears::invalid,
+                      [](const host::MotorPort& motor, int) { return static_cast<MotorGears>(motor.gearset); });
+}
+
+std::vector<std::int8_t> MotorGroup::get_port_all() const { return _ports; }
+
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+    return readMotor(_ports, index, PROS_ERR, [](const host::MotorPort& motor, int) { return motor.voltageLimit; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all() const {
+    return readMotors(_ports, PROS_ERR, [](const host::MotorPort& motor, int) { return motor.voltageLimit; });
+}
+
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const {
+    if (index >= _ports.size()) {
+        errno = EOVERFLOW;
+        return PROS_ERR;
+    }
+    return _ports[index] < 0;
+}
+
+std::vector<std::int32_t> MotorGroup::is_reversed_all() const {
+    std::vector<std::int32_t> reversed;
+    for (std::int8_t port : _ports) reversed.push_back(port < 0);
+    return reversed;
+}
+
+MotorType MotorGroup::get_type(const std::uint8_t index) const {
+    return readMotor(_ports, index, MotorType::invalid, [](const host::MotorPort&, int) { return MotorType::v5; });
+}
+
+std::vector<MotorType> MotorGroup::get_type_all() const {
+    return readMotors(_ports, MotorType::invalid, [](const host::MotorPort&, int) { return MotorType::v5; });
+}
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    return set_brake_mode(static_cast<motor_brake_mode_e_t>(mode), index);
+}
+
+std::int32_t MotorGroup::set_brake_mode(const motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return writeMotors(_ports, index, [&](host::MotorPort& motor, int) { motor.brakeMode = mode; });
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+    return set_brake_mode_all(static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const motor_brake_mode_e_t mode) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int) { motor.brakeMode = mode; });
+}
+
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return writeMotors(_ports, index, [&](host::MotorPort& motor, int) { motor.currentLimit = limit; });
+}
+
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int) { motor.currentLimit = limit; });
+}
+
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    return set_encoder_units(static_cast<motor_encoder_units_e_t>(units), index);
+}
+
+std::int32_t MotorGroup::set_encoder_units(const motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return writeMotors(_ports, index, [&](host::MotorPort& motor, int) { motor.units = units; });
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+    return set_encoder_units_all(static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const motor_encoder_units_e_t units) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int) { motor.units = units; });
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<motor_gearset_e_t> gearsets) const {
+    std::int32_t result = PROS_SUCCESS;
+    for (std::uint8_t i = 0; i < gearsets.size() && i < _ports.size(); i++) {
+        if (set_gearing(gearsets[i], i) != PROS_SUCCESS) result = PROS_ERR;
+    }
+    return result;
+}
+
+std::int32_t MotorGroup::set_gearing(const motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return writeMotors(_ports, index, [&](host::MotorPort& motor, int) { motor.gearset = gearset; });
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+    std::int32_t result = PROS_SUCCESS;
+    for (std::uint8_t i = 0; i < gearsets.size() && i < _ports.size(); i++) {
+        if (set_gearing(gearsets[i], i) != PROS_SUCCESS) result = PROS_ERR;
+    }
+    return result;
+}
+
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    return set_gearing(static_cast<motor_gearset_e_t>(gearset), index);
+}
+
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+    return set_gearing_all(static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t MotorGroup::set_gearing_all(const motor_gearset_e_t gearset) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int) { motor.gearset = gearset; });
+}
+
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+    if (index >= _ports.size()) {
+        errno = EOVERFLOW;
+        return PROS_ERR;
+    }
+    _ports[index] = static_cast<std::int8_t>(reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]));
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+    for (std::uint8_t i = 0; i < _ports.size(); i++) set_reversed(reverse, i);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return writeMotors(_ports, index, [&](host::MotorPort& motor, int) { motor.voltageLimit = limit; });
+}
+
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+    return writeMotors(_ports, -1, [&](host::MotorPort& motor, int) { motor.voltageLimit = limit; });
+}
+
+// The given position becomes the new zero
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+    return writeMotors(_ports, index,
+                       [&](host::MotorPort& motor, int dir) { motor.zero += dir * fromUnits(motor, position); });
+}
+
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+    return writeMotors(_ports, -1,
+                       [&](host::MotorPort& motor, int dir) { motor.zero += dir * fromUnits(motor, position); });
+}
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+    return writeMotors(_ports, index, [](host::MotorPort& motor, int) { motor.zero = motor.position; });
+}
+
+std::int32_t MotorGroup::tare_position_all() const {
+    return writeMotors(_ports, -1, [](host::MotorPort& motor, int) { motor.zero = motor.position; });
+}
+
+std::int8_t MotorGroup::size() const { return static_cast<std::int8_t>(_ports.size()); }
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const {
+    if (index >= _ports.size()) {
+        errno = EOVERFLOW;
+        return PROS_ERR_BYTE;
+    }
+    return _ports[index];
+}
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+
+void MotorGroup::append(AbstractMotor& other) {
+    for (std::int8_t port : other.get_port_all()) _ports.push_back(port);
+}
+
+void MotorGroup::erase_port(std::int8_t port) {
+    std::erase_if(_ports, [port](std::int8_t p) { return std::abs(p) == std::abs(port); });
+}
+
+// --- Imu ---
+namespace {
+
+host::ImuPort* imuOn(std::uint8_t port) {
+    host::SmartPort* slot = deviceOn(port, c::E_DEVICE_IMU);
+    return slot != nullptr ? &slot->imu : nullptr;
+}
+
+// The IMU answers nothing while it calibrates
+host::ImuPort* readyImu(std::uint8_t port) {
+    host::ImuPort* imu = imuOn(port);
+    if (imu != nullptr && imu->calibrating()) {
+        errno = EAGAIN;
+        return nullptr;
+    }
+    return imu;
+}
+
+template <typename F> std::int32_t writeImu(std::uint8_t port, F write) {
+    host::ImuPort* imu = readyImu(port);
+    if (imu == nullptr) return PROS_ERR;
+    write(*imu);
+    return PROS_SUCCESS;
+}
+
+} // namespace
+
+std::int32_t Imu::reset(bool blocking) const {
+    host::ImuPort* imu = imuOn(_port);
+    if (imu == nullptr) return PROS_ERR;
+    imu->startCalibration();
+    while (blocking && imu->calibrating()) c::delay(5);
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t) const { return imuOn(_port) != nullptr ? PROS_SUCCESS : PROS_ERR; }
+
+double Imu::get_rotation() const {
+    host::ImuPort* imu = readyImu(_port);
+    return imu != nullptr ? imu->rotation + imu->rotationOffset : PROS_ERR_F;
+}
+
+double Imu::get_heading() const {
+    host::ImuPort* imu = readyImu(_port);
+    return imu != nullptr ? wrap360(imu->rotation + imu->headingOffset) : PROS_ERR_F;
+}
+
+pros::quaternion_s_t Imu::get_quaternion() const {
+    host::ImuPort* imu = readyImu(_port);
+    if (imu == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    // Yaw only; pitch and roll are small on a drivetrain
+    double halfYaw = -wrap180(imu->rotation + imu->yawOffset) * M_PI / 360;
+    return {0, 0, std::sin(halfYaw), std::cos(halfYaw)};
+}
+
+pros::euler_s_t Imu::get_euler() const {
+    host::ImuPort* imu = readyImu(_port);
+    if (imu == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {imu->pitch + imu->pitchOffset, imu->roll + imu->rollOffset, wrap180(imu->rotation + imu->yawOffset)};
+}
+
+double Imu::get_pitch() const {
+    host::ImuPort* imu = readyImu(_port);
+    return imu != nullptr ? imu->pitch + imu->pitchOffset : PROS_ERR_F;
+}
+
+double Imu::get_roll() const {
+    host::ImuPort* imu = readyImu(_port);
+    return imu != nullptr ? imu->roll + imu->rollOffset : PROS_ERR_F;
+}
+
+double Imu::get_yaw() const {
+    host::ImuPort* imu = readyImu(_port);
+    return imu != nullptr ? wrap180(imu->rotation + imu->yawOffset) : PROS_ERR_F;
+}
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const {
+    host::ImuPort* imu = readyImu(_port);
+    if (imu == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {0, 0, imu->gyroZ};
+}
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return set_pitch(0); }
+
+std::int32_t Imu::tare_yaw() const { return set_yaw(0); }
+
+std::int32_t Imu::tare_roll() const { return set_roll(0); }
+
+std::int32_t Imu::tare() const {
+    return writeImu(_port, [](host::ImuPort& imu) {
+        imu.rotationOffset = imu.headingOffset = imu.yawOffset = -imu.rotation;
+        imu.pitchOffset = -imu.pitch;
+        imu.rollOffset = -imu.roll;
+    });
+}
+
+std::int32_t Imu::tare_euler() const { return set_euler({0, 0, 0}); }
+
+std::int32_t Imu::set_heading(const double target) const {
+    return writeImu(_port, [&](host::ImuPort& imu) { imu.headingOffset = target - imu.rotation; });
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+    return writeImu(_port, [&](host::ImuPort& imu) { imu.rotationOffset = target - imu.rotation; });
+}
+
+std::int32_t Imu::set_yaw(const double target) const {
+    return writeImu(_port, [&](host::ImuPort& imu) { imu.yawOffset = target - imu.rotation; });
+}
+
+std::int32_t Imu::set_pitch(const double target) const {
+    return writeImu(_port, [&](host::ImuPort& imu) { imu.pitchOffset = target - imu.pitch; });
+}
+
+std::int32_t Imu::set_roll(const double target) const {
+    return writeImu(_port, [&](host::ImuPort& imu) { imu.rollOffset = target - imu.roll; });
+}
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const {
+    return writeImu(_port, [&](host::ImuPort& imu) {
+        imu.pitchOffset = target.pitch - imu.pitch;
+        imu.rollOffset = target.roll - imu.roll;
+        imu.yawOffset = target.yaw - imu.rotation;
+    });
+}
+
+pros::imu_accel_s_t Imu::get_accel() const {
+    host::ImuPort* imu = readyImu(_port);
+    if (imu == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {imu->accelX, imu->accelY, imu->accelZ};
+}
+
+ImuStatus Imu::get_status() const {
+    host::ImuPort* imu = imuOn(_port);
+    if (imu == nullptr) return ImuStatus::error;
+    return imu->calibrating() ? ImuStatus::calibrating : ImuStatus::ready;
+}
+
+bool Imu::is_calibrating() const {
+    host::ImuPort* imu = imuOn(_port);
+    return imu != nullptr && imu->calibrating();
+}
+
+imu_orientation_e_t Imu::get_physical_orientation() const {
+    return imuOn(_port) != nullptr ? pros::E_IMU_Z_UP : pros::E_IMU_ORIENTATION_ERROR;
+}
+
+// --- Rotation ---
+namespace {
+
+host::RotationPort* rotationOn(std::uint8_t port) {
+    host::SmartPort* slot = deviceOn(port, c::E_DEVICE_ROTATION);
+    return slot != nullptr ? &slot->rotation : nullptr;
+}
+
+int rotationDirection(const host::RotationPort& sensor) { return sensor.reversed ? -1 : 1; }
+
+} // namespace
+
+// A negative port reverses the sensor, as in PROS
+Rotation::Rotation(const std::int8_t port) : Device(std::abs(port), DeviceType::rotation) {
+    if (host::SmartPort* slot = brain.port(port)) slot->rotation.reversed = port < 0;
+}
+
+std::int32_t Rotation::reset() {
+    host::RotationPort* sensor = rotationOn(_port);
+    if (sensor == nullptr) return PROS_ERR;
+    // The position becomes the current angle
+    double angle = wrap360(rotationDirection(*sensor) * sensor->angle);
+    sensor->zero = sensor->angle - rotationDirection(*sensor) * angle;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::set_data_rate(std::uint32_t) const {
+    return rotationOn(_port) != nullptr ? PROS_SUCCESS : PROS_ERR;
+}
+
+std::int32_t Rotation::set_position(std::int32_t position) const {
+    host::RotationPort* sensor = rotationOn(_port);
+    if (sensor == nullptr) return PROS_ERR;
+    sensor->zero = sensor->angle - rotationDirection(*sensor) * position / 100.0;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::reset_position() const { return set_position(0); }
+
+std::int32_t Rotation::get_position() const {
+    host::RotationPort* sensor = rotationOn(_port);
+    if (sensor == nullptr) return PROS_ERR;
+    return static_cast<std::int32_t>(std::lround(rotationDirection(*sensor) * (sensor->angle - sensor->zero) * 100));
+}
+
+std::int32_t Rotation::get_velocity() const {
+    host::RotationPort* sensor = rotationOn(_port);
+    if (sensor == nullptr) return PROS_ERR;
+    return static_cast<std::int32_t>(std::lround(rotationDirection(*sensor) * sensor->velocity * 100));
+}
+
+std::int32_t Rotation::get_angle() const {
+    host::RotationPort* sensor = rotationOn(_port);
+    if (sensor == nullptr) return PROS_ERR;
+    return static_cast<std::int32_t>(wrap360(rotationDirection(*sensor) * sensor->angle) * 100) % 36000;
+}
+
+std::int32_t Rotation::set_reversed(bool value) const {
+    host::RotationPort* sensor = rotationOn(_port);
+    if (sensor == nullptr) return PROS_ERR;
+    sensor->reversed = value;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::reverse() const {
+    host::RotationPort* sensor = rotationOn(_port);
+    if (sensor == nullptr) return PROS_ERR;
+    sensor->reversed = !sensor->reversed;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::get_reversed() const {
+    host::RotationPort* sensor = rotationOn(_port);
+    return sensor != nullptr ? sensor->reversed : PROS_ERR;
+}
+
+// --- Distance ---
+namespace {
+
+host::DistancePort* distanceOn(std::uint8_t port) {
+    host::SmartPort* slot = deviceOn(port, c::E_DEVICE_DISTANCE);
+    return slot != nullptr ? &slot->distance : nullptr;
+}
+
+} // namespace
+
+Distance::Distance(const std::uint8_t port) : Device(port, DeviceType::distance) {}
+
+std::int32_t Distance::get() {
+    host::DistancePort* sensor = distanceOn(_port);
+    return sensor != nullptr ? sensor->distance : PROS_ERR;
+}
+
+std::int32_t Distance::get_distance() { return get(); }
+
+std::int32_t Distance::get_confidence() {
+    host::DistancePort* sensor = distanceOn(_port);
+    return sensor != nullptr ? sensor->confidence : PROS_ERR;
+}
+
+std::int32_t Distance::get_object_size() {
+    host::DistancePort* sensor = distanceOn(_port);
+    return sensor != nullptr ? sensor->objectSize : PROS_ERR;
+}
+
+double Distance::get_object_velocity() {
+    host::DistancePort* sensor = distanceOn(_port);
+    return sensor != nullptr ? sensor->objectVelocity : PROS_ERR_F;
+}
+
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,178 @@
+// Controller, ADI, battery, competition and the odds and ends of the PROS API, backed by the host brain (brain.hpp)
+#include "brain.hpp"
+#include "kernel.hpp"
+#include "pros/adi.hpp"
+#include "pros/apix.h"
+#include "pros/llemu.hpp"
+#include "pros/misc.hpp"
+#include "pros/screen.hpp"
+#include <cerrno>
+#include <cstring>
+
+using host::brain;
+
+// The controller screen takes a new line this often
+#define CONTROLLER_TEXT_PERIOD 50
+// ADI port number of the smart port the brain's own ADI ports report
+#define INTERNAL_ADI_PORT 22
+
+// --- Controller ---
+namespace pros {
+inline namespace v5 {
+
+namespace {
+
+int buttonIndex(controller_digital_e_t button) { return button - E_CONTROLLER_DIGITAL_L1; }
+
+bool validButton(controller_digital_e_t button) {
+    if (buttonIndex(button) >= 0 && buttonIndex(button) < 13) return true;
+    errno = EINVAL;
+    return false;
+}
+
+} // namespace
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+std::int32_t Controller::is_connected() { return brain.controller.connected; }
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) {
+    if (channel < E_CONTROLLER_ANALOG_LEFT_X || channel > E_CONTROLLER_ANALOG_RIGHT_Y) {
+        errno = EINVAL;
+        return PROS_ERR;
+    }
+    return brain.controller.analog[channel];
+}
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) {
+    return validButton(button) && brain.controller.digital[buttonIndex(button)];
+}
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+    if (!validButton(button)) return 0;
+    int index = buttonIndex(button);
+    if (!brain.controller.digital[index]) {
+        brain.controller.pressReported[index] = false;
+        return 0;
+    }
+    if (brain.controller.pressReported[index]) return 0;
+    brain.controller.pressReported[index] = true;
+    return 1;
+}
+
+std::int32_t Controller::get_digital_new_release(controller_digital_e_t button) {
+    if (!validButton(button)) return 0;
+    int index = buttonIndex(button);
+    if (brain.controller.digital[index]) {
+        brain.controller.releaseReported[index] = false;
+        return 0;
+    }
+    if (brain.controller.releaseReported[index]) return 0;
+    brain.controller.releaseReported[index] = true;
+    return 1;
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) {
+    host::ControllerState& controller = brain.controller;
+    if (line > 2 || col > 18) {
+        errno = EINVAL;
+        return PROS_ERR;
+    }
+    // Writes faster than the controller takes them are dropped, as on the brain
+    uint32_t now = host::nowMs();
+    if (controller.textWritten && now - controller.lastText < CONTROLLER_TEXT_PERIOD) {
+        errno = EAGAIN;
+        return PROS_ERR;
+    }
+    controller.textWritten = true;
+    controller.lastText = now;
+    char* text = controller.text[line];
+    size_t length = std::min(std::strlen(str), sizeof(controller.text[line]) - 1 - col);
+    std::memset(text, ' ', col);
+    std::memcpy(text + col, str, length);
+    text[col + length] = '\0';
+    return 1;
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) {
+    return set_text(line, col, str.c_str());
+}
+
+std::int32_t Controller::clear_line(std::uint8_t line) { return set_text(line, 0, ""); }
+
+std::int32_t Controller::clear() {
+    for (std::uint8_t line = 0; line < 3; line++) brain.controller.text[line][0] = '\0';
+    return 1;
+}
+
+std::int32_t Controller::rumble(const char*) { return 1; }
+
+} // namespace v5
+
+// --- ADI ---
+namespace adi {
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t) : _smart_port(INTERNAL_ADI_PORT), _adi_port(adi_port) {
+    if (_adi_port >= 'a' && _adi_port <= 'h') _adi_port -= 'a' - 1;
+    else if (_adi_port >= 'A' && _adi_port <= 'H') _adi_port -= 'A' - 1;
+}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port, 0}; }
+
+std::int32_t Port::get_value() const {
+    if (_adi_port < 1 || _adi_port > 8) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    return brain.adi[_adi_port - 1];
+}
+
+AnalogIn::AnalogIn(std::uint8_t adi_port) : Port(adi_port, E_ADI_ANALOG_IN) {}
+
+Potentiometer::Potentiometer(std::uint8_t adi_port, adi_potentiometer_type_e_t) : AnalogIn(adi_port) {}
+
+// 250 degrees over the 12-bit range (the default EDR potentiometer)
+double Potentiometer::get_angle() const {
+    std::int32_t value = get_value();
+    return value == PROS_ERR ? PROS_ERR_F : value * 250.0 / 4095;
+}
+
+} // namespace adi
+
+// --- Battery, competition, SD card ---
+double battery::get_capacity() { return brain.batteryCapacity; }
+
+std::int32_t battery::get_voltage() { return brain.batteryVoltage; }
+
+std::int32_t battery::get_current() { return brain.batteryCurrent; }
+
+double battery::get_temperature() { return brain.batteryTemperature; }
+
+std::uint8_t competition::get_status() { return brain.competition; }
+
+std::uint8_t competition::is_autonomous() { return (brain.competition & COMPETITION_AUTONOMOUS) != 0; }
+
+std::uint8_t competition::is_connected() { return (brain.competition & COMPETITION_CONNECTED) != 0; }
+
+std::uint8_t competition::is_disabled() { return (brain.competition & COMPETITION_DISABLED) != 0; }
+
+// No card: everything under /usd fails to open, so logs and recordings stay in RAM
+std::int32_t usd::is_installed() { return 0; }
+
+// --- Brain screen ---
+// Nothing is drawn; the host reports the pose itself
+std::uint32_t screen::erase() { return 1; }
+
+namespace lcd {
+bool initialize() { return true; }
+bool is_initialized() { return true; }
+} // namespace lcd
+
+} // namespace pros
+
+std::int32_t pros::c::controller_rumble(controller_id_e_t, const char*) { return 1; }
+
+std::uint32_t pros::c::screen_print(text_format_e_t, const int16_t, const char*, ...) { return 1; }
+
+// Serial settings only matter to the brain's USB link
+std::int32_t pros::c::serctl(const uint32_t, void* const) { return 0; }
@@ -0,0 +1,93 @@
+#include "replay.hpp"
+#include "brain.hpp"
+#include "robot_config.hpp"
+
+namespace host {
+
+namespace {
+
+constexpr int LEFT_PORTS[] = {PORT_LEFT_MOTOR_1, PORT_LEFT_MOTOR_2, PORT_LEFT_MOTOR_3};
+constexpr int RIGHT_PORTS[] = {PORT_RIGHT_MOTOR_1, PORT_RIGHT_MOTOR_2, PORT_RIGHT_MOTOR_3};
+// Same order as InputRecord::distance
+constexpr int DISTANCE_PORTS[] = {PORT_DISTANCE_RIGHT, PORT_DISTANCE_LEFT, PORT_DISTANCE_FRONT, PORT_DISTANCE_BACK};
+
+int direction(int port) { return port < 0 ? -1 : 1; }
+
+// Raw rotation sensor angle that reads as `centidegrees`
+void writeRotation(int port, int32_t centidegrees, double dt) {
+    RotationPort& sensor = brain.port(port)->rotation;
+    double angle = sensor.zero + (sensor.reversed ? -1 : 1) * centidegrees / 100.0;
+    if (dt > 0) sensor.velocity = (angle - sensor.angle) / dt;
+    sensor.angle = angle;
+}
+
+void writeMotors(const int (&ports)[3], const int32_t (&centidegrees)[3], double dt) {
+    for (int i = 0; i < 3; i++) {
+        MotorPort& motor = brain.port(ports[i])->motor;
+        double position = motor.zero + direction(ports[i]) * centidegrees[i] / 100.0;
+        if (dt > 0) motor.velocity = (position - motor.position) / dt / 6; // Degrees per second to rpm
+        motor.position = position;
+    }
+}
+
+// Average drive command of a side, mV, robot-forward positive
+int32_t sideCommand(const int (&ports)[3]) {
+    int32_t total = 0;
+    for (int port : ports) total += direction(port) * brain.port(port)->motor.commandedVoltage();
+    return total / 3;
+}
+
+} // namespace
+
+ReplayWorld::ReplayWorld(const InputLogHeader& header, std::vector<InputRecord> records)
+    : header(header), records(std::move(records)) {
+    if (!this->records.empty()) write(this->records.front(), 0);
+}
+
+void ReplayWorld::begin(uint32_t now) {
+    playing = true;
+    startTime = now;
+    // Written again right away: the program may have zeroed or tared devices since the constructor held it
+    if (next == 0 && !records.empty()) write(records[next++], 0);
+}
+
+uint32_t ReplayWorld::duration() const {
+    return records.empty() ? 0 : records.back().time - records.front().time + header.period;
+}
+
+void ReplayWorld::step(uint32_t now) {
+    if (!playing) return;
+    // A record applies from its own time until the next one, as the device snapshot did on the robot
+    while (next < records.size() && records[next].time - records.front().time <= now - startTime) {
+        if (trace != nullptr && next > 0) {
+            std::fprintf(trace, "%u,%d,%d\n", records[next - 1].time - records.front().time, sideCommand(LEFT_PORTS),
+                         sideCommand(RIGHT_PORTS));
+        }
+        double dt = next > 0 ? (records[next].time - records[next - 1].time) / 1000.0 : 0;
+        write(records[next++], dt);
+    }
+}
+
+void ReplayWorld::write(const InputRecord& record, double dt) {
+    writeRotation(PORT_HORIZONTAL_ENCODER, record.horizontalPosition, dt);
+    writeRotation(PORT_VERTICAL_ENCODER, record.verticalPosition, dt);
+    writeMotors(LEFT_PORTS, record.leftMotorPosition, dt);
+    writeMotors(RIGHT_PORTS, record.rightMotorPosition, dt);
+
+    // get_rotation() is what odometry reads; the heading follows it through its own tare
+    ImuPort& imu = brain.port(PORT_IMU)->imu;
+    imu.rotation = record.imuRotation - imu.rotationOffset;
+    imu.gyroZ = record.imuGyroZ;
+
+    for (int i = 0; i < 4; i++) {
+        DistancePort& sensor = brain.port(DISTANCE_PORTS[i])->distance;
+        sensor.distance = record.distance[i];
+        sensor.confidence = record.distance[i] < 9999 ? 63 : 0;
+        sensor.objectSize = record.distance[i] < 9999 ? 400 : 0;
+    }
+
+    for (int i = 0; i < 4; i++) brain.controller.analog[i] = record.sticks[i];
+    for (int i = 0; i < 13; i++) brain.controller.digital[i] = (record.buttons >> i) & 1;
+}
+
+} // namespace host
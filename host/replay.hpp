@@ -0,0 +1,45 @@
+#ifndef HOST_REPLAY_HPP
+#define HOST_REPLAY_HPP
+
+#include "input_log.hpp"
+#include "world.hpp"
+#include <cstdio>
+#include <vector>
+
+// --- Replay World ---
+// Plays an input log recorded on the robot (input_recorder.hpp, /usd/inputs_NNN.bin) back into the brain instead of
+// simulating the robot: every device reads what it read on the field, record by record, on the virtual clock. The
+// values are written against each device's current zero and tare, so resets made by the replayed program don't shift
+// them. Motor commands go nowhere (the control code runs open loop against the real run); an optional trace keeps
+// what it commanded, for comparing control changes against recorded runs.
+
+namespace host {
+
+class ReplayWorld : public World {
+    public:
+        ReplayWorld(const InputLogHeader& header, std::vector<InputRecord> records);
+        // Starts playing the records at `now`; until then the first one is held
+        void begin(uint32_t now);
+        // Writes "time_ms,left_mv,right_mv" for every record played from begin() on (the drive command each side
+        // got in the record's period, robot-forward positive)
+        void setTrace(std::FILE* file) { trace = file; }
+        // Length of the recording, ms
+        uint32_t duration() const;
+        void step(uint32_t now) override;
+        // The log has no ground truth; the robot reads as staying at the origin
+        FieldPose pose() const override { return {}; }
+    private:
+        // `dt`: seconds since the previous record, for the velocities (0 for none)
+        void write(const InputRecord& record, double dt);
+
+        InputLogHeader header;
+        std::vector<InputRecord> records;
+        size_t next = 0;         // First record not yet written
+        bool playing = false;
+        uint32_t startTime = 0;  // Virtual time of the first record
+        std::FILE* trace = nullptr;
+};
+
+} // namespace host
+
+#endif
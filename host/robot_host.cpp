@@ -0,0 +1,314 @@
+// Runs the robot program through one match start on the host: initialize(), a disabled period with
+// competition_initialize(), autonomous() and then disabled(), all on the virtual clock (kernel.hpp) against the world
+// model (world.hpp). Prints one RESULT line to stderr:
+//   RESULT auton=1 alliance=red completed=1 time_ms=5230 x=.. y=.. theta=.. odom_x=.. odom_y=.. odom_theta=..
+// completed is 1 when autonomous() returned and the chassis stopped moving within the autonomous period, time_ms is
+// how long that took, and both poses are in the auton's own (red) coordinates.
+//
+// Usage: robot_host [--auton N] [--blue] [--start X,Y,THETA] [--start-error DX,DY,DTHETA] [--disabled MS]
+//                   [--auton-time MS] [--serial FILE] [--world physics|ideal] [--seed N] [--battery VOLTS]
+//                   [--traction SCALE] [--noise SCALE] [--timing] [--list] [--replay FILE [--trace FILE]]
+//                   [--macro FILE]
+//   --start      where the robot really is (default: the auton's start pose)
+//   --start-error  placement error added to that pose, in the auton's own coordinates
+//   --serial     where the program's terminal output goes (default: discarded)
+//   --world      physics (default, physics.hpp) or the kinematic ideal world with exact sensors
+//   --seed       seeds the physics world's sensor noise; equal seeds give identical runs
+//   --battery    open-circuit battery voltage; --traction and --noise scale the default tread friction and sensor noise
+//   --timing     also prints "TIMING sim_ms=.. wall_ms=.. speedup=.." to stderr
+//   --list       prints "AUTON <n> <name>" to stderr for every auton and exits
+//   --replay     plays an input log from the robot (inputs_NNN.bin) into the devices instead of simulating (replay.hpp).
+//                The log picks the auton and alliance; a driver control log runs opcontrol() for its length. Prints
+//                  REPLAY mode=auton auton=1 alliance=red records=.. completed=1 time_ms=.. odom_x=.. odom_y=.. odom_theta=..
+//                instead of RESULT.
+//   --trace      with --replay, writes the drive commands the program gave as CSV (time_ms,left_mv,right_mv)
+//   --macro      plays a driver macro (macro.hpp, /usd/macro.bin) with playMacro() from an autonomous period instead
+//                of running an auton. The robot starts on the macro's start pose (plus --start-error). Prints
+//                  MACRO frames=.. completed=1 time_ms=.. x=.. y=.. theta=.. target_x=.. target_y=.. target_theta=..
+//                  error=.. error_theta=..
+//                instead of RESULT, where target is the last recorded pose and error its distance from where the
+//                robot really ended.
+#include "brain.hpp"
+#include "kernel.hpp"
+#include "main.h"
+#include "auton_registry.hpp"
+#include "macro.hpp"
+#include "robot_config.hpp"
+#include "physics.hpp"
+#include "replay.hpp"
+#include "startup.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#define INITIALIZE_TIMEOUT 10000  // ms initialize() may take before the run is abandoned
+#define DISABLED_TIME 3000        // ms between initialize() and autonomous, as on a field
+#define AUTON_TIME 15000          // Length of the autonomous period
+#define SETTLE_TIME 500           // ms of disabled() after autonomous, so motions see the state change and stop
+#define MACRO_MARGIN 1000         // ms past a macro's length before its playback counts as not completed
+#define TEAM_POT_BLUE 4000        // Team pot reading past the red half of its range
+
+using host::brain;
+
+namespace {
+
+struct Options {
+    int auton = 1;
+    bool red = true;
+    bool startGiven = false;
+    host::FieldPose start;
+    host::FieldPose startError;
+    uint32_t disabledTime = DISABLED_TIME;
+    uint32_t autonTime = AUTON_TIME;
+    const char* serial = "/dev/null";
+    bool physics = true;
+    host::PhysicsConfig config;
+    bool timing = false;
+    bool list = false;
+    const char* replay = nullptr;
+    const char* trace = nullptr;
+    const char* macro = nullptr;
+};
+
+// Scales every sensor error of the default physics config
+void scaleNoise(host::SensorNoise& noise, double scale) {
+    noise.rotation *= scale;
+    noise.gyroNoise *= scale;
+    noise.gyroBias *= scale;
+    noise.gyroScale *= scale;
+    noise.distanceFraction *= scale;
+    noise.distanceMinimum *= scale;
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--blue") == 0) {
+            options.red = false;
+            continue;
+        }
+        if (std::strcmp(arg, "--timing") == 0) {
+            options.timing = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--list") == 0) {
+            options.list = true;
+            continue;
+        }
+        if (value == nullptr) return false;
+        i++;
+        if (std::strcmp(arg, "--auton") == 0) options.auton = std::atoi(value);
+        else if (std::strcmp(arg, "--disabled") == 0) options.disabledTime = std::atoi(value);
+        else if (std::strcmp(arg, "--auton-time") == 0) options.autonTime = std::atoi(value);
+        else if (std::strcmp(arg, "--serial") == 0) options.serial = value;
+        else if (std::strcmp(arg, "--replay") == 0) options.replay = value;
+        else if (std::strcmp(arg, "--trace") == 0) options.trace = value;
+        else if (std::strcmp(arg, "--macro") == 0) options.macro = value;
+        else if (std::strcmp(arg, "--seed") == 0) options.config.seed = std::strtoull(value, nullptr, 0);
+        else if (std::strcmp(arg, "--battery") == 0) options.config.batteryVoltage = std::atof(value);
+        else if (std::strcmp(arg, "--noise") == 0) scaleNoise(options.config.noise, std::atof(value));
+        else if (std::strcmp(arg, "--traction") == 0) {
+            options.config.traction *= std::atof(value);
+            options.config.lateralTraction *= std::atof(value);
+        } else if (std::strcmp(arg, "--world") == 0) {
+            if (std::strcmp(value, "physics") == 0) options.physics = true;
+            else if (std::strcmp(value, "ideal") == 0) options.physics = false;
+            else return false;
+        } else if (std::strcmp(arg, "--start") == 0) {
+            options.startGiven = true;
+            if (std::sscanf(value, "%lf,%lf,%lf", &options.start.x, &options.start.y, &options.start.theta) != 3) {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--start-error") == 0) {
+            host::FieldPose& error = options.startError;
+            if (std::sscanf(value, "%lf,%lf,%lf", &error.x, &error.y, &error.theta) != 3) return false;
+        } else return false;
+    }
+    if (options.trace != nullptr && options.replay == nullptr) return false;
+    if (options.macro != nullptr && (options.replay != nullptr || options.startGiven)) return false;
+    return options.auton >= 1 && options.auton <= AUTON_COUNT;
+}
+
+// Pot reading in the middle of the auton's slice of the selector range (autonFromPot())
+int32_t autonPotValue(int auton) { return ((auton - 1) * (AUTON_POT_RANGE + 1) + (AUTON_POT_RANGE + 1) / 2) / AUTON_COUNT; }
+
+host::FieldPose toFieldPose(const StartPose& pose) { return {pose.x, pose.y, pose.theta}; }
+
+// Alliance frame changes are their own inverse, so this also takes blue field poses back to the auton's frame
+host::FieldPose allianceFrame(const host::FieldPose& pose, bool red) {
+    StartPose turned = allianceStartPose(StartPose {float(pose.x), float(pose.y), float(pose.theta)}, red);
+    host::FieldPose result = toFieldPose(turned);
+    result.theta = std::remainder(result.theta, 360);
+    return result;
+}
+
+pros::task_t startTask(const char* name, void (*entry)()) {
+    return pros::c::task_create([](void* entry) { reinterpret_cast<void (*)()>(entry)(); },
+                                reinterpret_cast<void*>(entry), TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name);
+}
+
+uint32_t autonEnd = 0;
+const char* macroPath = nullptr;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--auton 1-%d] [--blue] [--start X,Y,THETA] [--start-error DX,DY,DTHETA] "
+                             "[--disabled MS] [--auton-time MS] [--serial FILE] [--world physics|ideal] [--seed N] "
+                             "[--battery VOLTS] [--traction SCALE] [--noise SCALE] [--timing] [--list] [--replay FILE [--trace FILE]] [--macro FILE]\n",
+                     argv[0], AUTON_COUNT);
+        return 2;
+    }
+    if (options.list) {
+        for (int i = 1; i <= AUTON_COUNT; i++) std::fprintf(stderr, "AUTON %d %s\n", i, autonDescriptor(i).name);
+        return 0;
+    }
+    // The parameter server reads stdin and the terminal output is binary-framed; keep both off the console
+    if (std::freopen("/dev/null", "r", stdin) == nullptr || std::freopen(options.serial, "w", stdout) == nullptr) {
+        std::perror("robot_host");
+        return 1;
+    }
+
+    // A replayed log brings its own auton and alliance
+    InputLogHeader replayHeader;
+    std::vector<InputRecord> records;
+    bool driver = false;
+    if (options.replay != nullptr) {
+        if (!readInputLog(options.replay, replayHeader, records) || records.empty()) {
+            std::fprintf(stderr, "robot_host: can't read input log %s\n", options.replay);
+            return 1;
+        }
+        driver = replayHeader.auton == 0;
+        if (!driver) options.auton = replayHeader.auton;
+        options.red = replayHeader.red != 0;
+        if (options.auton > AUTON_COUNT) {
+            std::fprintf(stderr, "robot_host: %s was recorded with auton %d, which no longer exists\n", options.replay,
+                         options.auton);
+            return 1;
+        }
+    }
+    // A macro brings its own start pose; the program loads it again itself, as from the SD card
+    MacroHeader macroStart;
+    std::vector<MacroFrame> macroFrames;
+    if (options.macro != nullptr) {
+        if (!readMacro(options.macro, macroStart, macroFrames, MACRO_MAX_FRAMES) || macroFrames.empty()) {
+            std::fprintf(stderr, "robot_host: can't read macro %s\n", options.macro);
+            return 1;
+        }
+        options.red = true;
+        options.start = {macroStart.startX, macroStart.startY, macroStart.startTheta};
+        options.startGiven = true;
+        macroPath = options.macro;
+    }
+    std::FILE* trace = nullptr;
+    if (options.trace != nullptr && (trace = std::fopen(options.trace, "w")) == nullptr) {
+        std::perror(options.trace);
+        return 1;
+    }
+
+    brain.adi[PORT_AUTON_SELECTOR_POT - 1] = autonPotValue(options.auton);
+    brain.adi[PORT_TEAM_SELECTOR_POT - 1] = options.red ? 0 : TEAM_POT_BLUE;
+    const AutonDescriptor& auton = autonDescriptor(options.auton);
+    host::FieldPose start = options.startGiven ? allianceFrame(options.start, options.red) : toFieldPose(auton.start);
+    start.x += options.startError.x;
+    start.y += options.startError.y;
+    start.theta += options.startError.theta;
+    start = allianceFrame(start, options.red);
+    std::unique_ptr<host::World> world;
+    host::ReplayWorld* replay = nullptr;
+    if (options.replay != nullptr) {
+        world = std::make_unique<host::ReplayWorld>(replayHeader, std::move(records));
+        replay = static_cast<host::ReplayWorld*>(world.get());
+        if (trace != nullptr) std::fprintf(trace, "time_ms,left_mv,right_mv\n");
+        replay->setTrace(trace);
+    } else if (options.physics) world = std::make_unique<host::PhysicsWorld>(start, options.config);
+    else world = std::make_unique<host::IdealWorld>(start);
+    host::setTickHook([&](uint32_t now) { world->step(now); });
+    auto wallStart = std::chrono::steady_clock::now();
+
+    startTask("initialize", [] {
+        initialize();
+        host::stop(0);
+    });
+    if (host::run(INITIALIZE_TIMEOUT) != 0) {
+        std::fprintf(stderr, "robot_host: initialize() did not return within %d ms\n", INITIALIZE_TIMEOUT);
+        return 1;
+    }
+
+    pros::task_t competitionTask = startTask("competition_initialize", [] { competition_initialize(); });
+    host::run(host::nowMs() + options.disabledTime);
+
+    // A mode change deletes the running competition task and starts the next mode in a new one
+    brain.competition = driver ? COMPETITION_CONNECTED : COMPETITION_AUTONOMOUS | COMPETITION_CONNECTED;
+    pros::c::task_delete(competitionTask);
+    uint32_t autonStart = host::nowMs();
+    if (replay != nullptr) replay->begin(autonStart);
+    bool completed;
+    if (options.macro != nullptr) {
+        competitionTask = startTask("macro", [] {
+            waitForStartup(STARTUP_ALL);
+            if (loadMacro(macroPath)) playMacro(true);
+            autonEnd = host::nowMs();
+            host::stop(0);
+        });
+        completed = host::run(autonStart + macroFrames.size() * macroStart.period + MACRO_MARGIN) == 0;
+    } else if (driver) {
+        // Driver control has no end of its own; it lasts as long as the recording
+        competitionTask = startTask("opcontrol", [] { opcontrol(); });
+        host::run(autonStart + replay->duration());
+        autonEnd = host::nowMs();
+        completed = true;
+    } else {
+        competitionTask = startTask("autonomous", [] {
+            autonomous();
+            while (chassis.isInMotion()) pros::delay(10); // The last motion may still be running asynchronously
+            autonEnd = host::nowMs();
+            host::stop(0);
+        });
+        completed = host::run(autonStart + options.autonTime) == 0;
+    }
+
+    brain.competition = COMPETITION_DISABLED | COMPETITION_CONNECTED;
+    pros::c::task_delete(competitionTask);
+    startTask("disabled", [] { disabled(); });
+    host::run(host::nowMs() + SETTLE_TIME);
+
+    host::FieldPose truth = allianceFrame(world->pose(), options.red);
+    lemlib::Pose odom = chassis.getPose();
+    if (options.macro != nullptr) {
+        const MacroFrame& last = macroFrames.back();
+        double dx = truth.x - frameX(last), dy = truth.y - frameY(last);
+        std::fprintf(stderr,
+                     "MACRO frames=%zu completed=%d time_ms=%u x=%.3f y=%.3f theta=%.3f target_x=%.3f target_y=%.3f "
+                     "target_theta=%.3f error=%.3f error_theta=%.3f\n",
+                     macroFrames.size(), completed, completed ? autonEnd - autonStart : 0, truth.x, truth.y,
+                     truth.theta, frameX(last), frameY(last), frameTheta(last), std::hypot(dx, dy),
+                     std::remainder(truth.theta - frameTheta(last), 360.0));
+    } else if (replay != nullptr) {
+        std::fprintf(stderr,
+                     "REPLAY mode=%s auton=%d alliance=%s records=%u completed=%d time_ms=%u odom_x=%.3f odom_y=%.3f "
+                     "odom_theta=%.3f\n",
+                     driver ? "driver" : "auton", driver ? 0 : options.auton, options.red ? "red" : "blue",
+                     replayHeader.count, completed, completed ? autonEnd - autonStart : 0, odom.x, odom.y,
+                     std::remainder(odom.theta, 360.0f));
+        if (trace != nullptr) std::fclose(trace);
+    } else std::fprintf(stderr,
+                 "RESULT auton=%d alliance=%s completed=%d time_ms=%u x=%.3f y=%.3f theta=%.3f odom_x=%.3f "
+                 "odom_y=%.3f odom_theta=%.3f\n",
+                 options.auton, options.red ? "red" : "blue", completed, completed ? autonEnd - autonStart : 0,
+                 truth.x, truth.y, truth.theta, odom.x, odom.y, std::remainder(odom.theta, 360.0f));
+    if (options.timing) {
+        double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+        std::fprintf(stderr, "TIMING sim_ms=%u wall_ms=%.1f speedup=%.0f\n", host::nowMs(), wallMs,
+                     host::nowMs() / wallMs);
+    }
+    std::fflush(stdout);
+    // Tasks are abandoned mid-flight, like a powered-off brain; skip the global destructors they might still use
+    std::_Exit(0);
+}
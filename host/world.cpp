@@ -0,0 +1,160 @@
+#include "world.hpp"
+#include "brain.hpp"
+#include "robot_config.hpp"
+#include "start_tile.hpp"
+#include <cmath>
+
+// Distance sensor range; farther walls read as nothing in range
+#define DISTANCE_MAX_RANGE 2000
+#define MM_PER_INCH 25.4
+
+namespace host {
+
+namespace {
+
+constexpr double DEG_TO_RAD = M_PI / 180;
+
+int direction(int port) { return port < 0 ? -1 : 1; }
+
+// Same mounts as the start detection (auton_registry.cpp): degrees clockwise from the front, inches to the face
+struct DistanceMount {
+    int port;
+    double angle;
+    double offset;
+};
+
+constexpr DistanceMount DISTANCE_MOUNTS[] = {
+    {PORT_DISTANCE_RIGHT, 90, DS_RIGHT_CENTER},
+    {PORT_DISTANCE_LEFT, -90, DS_LEFT_CENTER},
+    {PORT_DISTANCE_FRONT, 0, DS_FRONT_CENTER},
+    {PORT_DISTANCE_BACK, 180, DS_BACK_CENTER},
+};
+
+constexpr int LEFT_PORTS[] = {PORT_LEFT_MOTOR_1, PORT_LEFT_MOTOR_2, PORT_LEFT_MOTOR_3};
+constexpr int RIGHT_PORTS[] = {PORT_RIGHT_MOTOR_1, PORT_RIGHT_MOTOR_2, PORT_RIGHT_MOTOR_3};
+
+// Wheel rpm per motor rpm (the external gearing)
+double wheelRatio(const MotorPort& motor) { return WHEEL_RPM / motor.maxRpm(); }
+
+// Speed (wheel rpm, robot-forward positive) the motor drives its wheel toward, and how fast it gets there (ms)
+void motorTarget(const MotorPort& motor, int dir, double wheelRpm, double& target, double& tau) {
+    double ratio = wheelRatio(motor);
+    if (motor.stopping()) {
+        target = 0;
+        switch (motor.brakeMode) {
+            case pros::E_MOTOR_BRAKE_HOLD: tau = 5; break;
+            case pros::E_MOTOR_BRAKE_BRAKE: tau = 20; break;
+            default: tau = 300; break; // Coasting on the drivetrain's own friction
+        }
+        return;
+    }
+    tau = 60;
+    switch (motor.mode) {
+        case MotorMode::VOLTAGE: target = dir * motor.commandedVoltage() / 12000.0 * WHEEL_RPM; break;
+        case MotorMode::VELOCITY: target = dir * motor.targetVelocity * ratio; break;
+        case MotorMode::POSITION: {
+            // Proportional approach to the target, capped at the profile velocity
+            double error = dir * (motor.targetPosition - motor.position);
+            double limit = std::abs(motor.targetVelocity) * ratio;
+            target = std::clamp(error * 2 * ratio, -limit, limit);
+            break;
+        }
+        default: target = wheelRpm; break;
+    }
+}
+
+// Moves one side's motors together (they share a shaft through the wheels)
+double stepSide(const int (&ports)[3], double wheelRpm, double dtMs) {
+    double target = 0;
+    double tau = 1e9;
+    for (int port : ports) {
+        double motorTargetRpm, motorTau;
+        motorTarget(brain.port(port)->motor, direction(port), wheelRpm, motorTargetRpm, motorTau);
+        target += motorTargetRpm / 3;
+        tau = std::min(tau, motorTau);
+    }
+    wheelRpm += (target - wheelRpm) * std::min(1.0, dtMs / tau);
+    for (int port : ports) {
+        MotorPort& motor = brain.port(port)->motor;
+        motor.velocity = direction(port) * wheelRpm / wheelRatio(motor);
+        motor.position += motor.velocity * 6 * dtMs / 1000;
+        motor.voltage = motor.commandedVoltage();
+    }
+    return wheelRpm;
+}
+
+// Inches per second at the tread for a wheel speed
+double surfaceSpeed(double wheelRpm) { return wheelRpm / 60 * M_PI * WHEEL_DIAMETER; }
+
+} // namespace
+
+IdealWorld::IdealWorld(const FieldPose& start) : robot(start) { sensors.write(robot, 0, 0, 0, 0); }
+
+void IdealWorld::step(uint32_t now) {
+    double dtMs = now - lastStep;
+    lastStep = now;
+    if (dtMs <= 0) return;
+    leftRpm = stepSide(LEFT_PORTS, leftRpm, dtMs);
+    rightRpm = stepSide(RIGHT_PORTS, rightRpm, dtMs);
+
+    double dt = dtMs / 1000;
+    double left = surfaceSpeed(leftRpm);
+    double right = surfaceSpeed(rightRpm);
+    double forward = (left + right) / 2;
+    double omega = (left - right) / TRACK_WIDTH / DEG_TO_RAD;
+    // Advance along the arc using the midpoint heading
+    double heading = (robot.theta + omega * dt / 2) * DEG_TO_RAD;
+    robot.x += forward * std::sin(heading) * dt;
+    robot.y += forward * std::cos(heading) * dt;
+    robot.theta += omega * dt;
+    sensors.write(robot, forward, 0, omega, dt);
+}
+
+// --- SensorModel ---
+SensorModel::SensorModel(const SensorNoise& noise, uint64_t seed) : noise(noise), random(seed) {
+    gyroBias = gaussian(noise.gyroBias);
+    gyroScale = gaussian(noise.gyroScale);
+}
+
+double SensorModel::gaussian(double sigma) { return sigma > 0 ? normal(random) * sigma : 0; }
+
+void SensorModel::write(const FieldPose& pose, double forward, double left, double omega, double dt) {
+    // Tracking wheels: a wheel off the tracking center also sees the rotation (offsets as in LemLib: vertical wheels
+    // right-positive, horizontal wheels forward-positive; horizontal travel is positive to the left)
+    double omegaRad = omega * DEG_TO_RAD;
+    double verticalSpeed = forward - omegaRad * VERTICAL_TRACKING_OFFSET;
+    double horizontalSpeed = left - omegaRad * HORIZONTAL_TRACKING_OFFSET;
+    auto turnWheel = [&](int port, double& angle, double speed) {
+        RotationPort& sensor = brain.port(port)->rotation;
+        double degreesPerSecond = speed / (M_PI * WHEEL_DIAMETER) * 360;
+        angle += degreesPerSecond * dt;
+        // The sensor's raw direction is opposite on a reversed port
+        sensor.velocity = direction(port) * degreesPerSecond;
+        sensor.angle = direction(port) * (angle + gaussian(noise.rotation));
+    };
+    turnWheel(PORT_VERTICAL_ENCODER, verticalAngle, verticalSpeed);
+    turnWheel(PORT_HORIZONTAL_ENCODER, horizontalAngle, horizontalSpeed);
+
+    // The IMU integrates its own gyro, so its errors accumulate into the heading
+    ImuPort& imu = brain.port(PORT_IMU)->imu;
+    imu.gyroZ = omega * (1 + gyroScale) + gyroBias + gaussian(noise.gyroNoise);
+    imu.turn(imu.gyroZ * dt);
+
+    for (const DistanceMount& mount : DISTANCE_MOUNTS) {
+        DistancePort& sensor = brain.port(mount.port)->distance;
+        double inches = wallDistance(pose.x, pose.y, pose.theta + mount.angle, FIELD_HALF_WIDTH) - mount.offset;
+        double mm = inches * MM_PER_INCH;
+        mm += gaussian(std::max(noise.distanceMinimum, noise.distanceFraction * mm));
+        if (mm < 0 || mm > DISTANCE_MAX_RANGE) {
+            sensor.distance = 9999;
+            sensor.confidence = 0;
+            sensor.objectSize = 0;
+        } else {
+            sensor.distance = static_cast<int32_t>(std::lround(mm));
+            sensor.confidence = 63;
+            sensor.objectSize = 400; // A wall fills the view
+        }
+    }
+}
+
+} // namespace host
@@ -0,0 +1,70 @@
+#ifndef HOST_WORLD_HPP
+#define HOST_WORLD_HPP
+
+#include <cstdint>
+#include <random>
+
+// --- Host World ---
+// Moves the simulated robot once per tick: reads the motor commands from the brain (brain.hpp), advances the
+// robot's true pose and writes back what every device would measure. Installed as the kernel's tick hook.
+
+namespace host {
+
+// Field pose in LemLib's convention: inches, heading in degrees clockwise from +Y
+struct FieldPose {
+    double x = 0, y = 0, theta = 0;
+};
+
+class World {
+    public:
+        virtual ~World() = default;
+        // Advances to `now` (ms) and writes the new measurements into the brain
+        virtual void step(uint32_t now) = 0;
+        // Where the robot really is
+        virtual FieldPose pose() const = 0;
+};
+
+// Measurement errors; all zero reads exact values
+struct SensorNoise {
+    double rotation = 0;          // Degrees (1 sigma) on each tracking wheel reading
+    double gyroNoise = 0;         // Degrees/s (1 sigma) on each IMU sample, integrated into the heading
+    double gyroBias = 0;          // Degrees/s (1 sigma) of the bias drawn once per run
+    double gyroScale = 0;         // Fraction (1 sigma) of the scale error drawn once per run
+    double distanceFraction = 0;  // Distance sensor error (1 sigma) as a fraction of the range...
+    double distanceMinimum = 0;   // ...but at least this many mm
+};
+
+// Writes the tracking wheels, IMU and distance sensors. Shared by every world model.
+class SensorModel {
+    public:
+        explicit SensorModel(const SensorNoise& noise = {}, uint64_t seed = 0);
+        // For a robot at `pose` that moved with forward speed `forward` and leftward speed `left` (in/s) and turned at
+        // `omega` (degrees/s, clockwise) during the last `dt` seconds
+        void write(const FieldPose& pose, double forward, double left, double omega, double dt);
+    private:
+        double gaussian(double sigma);
+
+        SensorNoise noise;
+        std::mt19937_64 random;
+        std::normal_distribution<double> normal;
+        double gyroBias, gyroScale;
+        double verticalAngle = 0, horizontalAngle = 0; // True wheel angles (degrees), before reading noise
+};
+
+// Kinematic differential drive: every drive motor reaches its commanded speed with a first-order lag, the wheels
+// never slip and the sensors read exact values. Good for checking program logic, not for tuning.
+class IdealWorld : public World {
+    public:
+        explicit IdealWorld(const FieldPose& start);
+        void step(uint32_t now) override;
+        FieldPose pose() const override { return robot; }
+    private:
+        FieldPose robot;
+        SensorModel sensors;
+        double leftRpm = 0, rightRpm = 0; // Wheel speeds
+        uint32_t lastStep = 0;
+};
+
+} // namespace host
+
+#endif
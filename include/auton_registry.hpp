@@ -0,0 +1,61 @@
+#ifndef AUTON_REGISTRY_HPP
+#define AUTON_REGISTRY_HPP
+
+#include "main.h"
+#include "lemlib/asset.hpp"
+#include "start_tile.hpp"
+
+// --- Auton Registry ---
+// Every autonomous routine is described once in AUTONS (autons.cpp): its name, field side, start pose, the path
+// assets it follows and an optional prepare hook. While the robot is disabled and the selector pot has stopped moving,
+// the selected auton is prepared (paths parsed into the path cache, then its hook run), so autonomous() only has to
+// set the start pose and go. Start poses are in field coordinates for the red alliance (blue is the same pose turned
+// about the field center); autons still at the origin are written relative to wherever the robot is placed.
+
+enum class AutonSide { ANY, LEFT, RIGHT, SKILLS };
+
+#define AUTON_MAX_PATHS 4
+
+struct AutonDescriptor {
+    const char* name;
+    AutonSide side;                      // Shown with the selection, so the robot gets placed on the right side
+    StartPose start;
+    const asset* paths[AUTON_MAX_PATHS]; // Unused entries are nullptr
+    void (*prepare)();                   // Extra setup run while disabled (nullptr for none)
+    void (*run)();
+};
+
+// Defined in autons.cpp; selections are 1-based (selectedAuton)
+extern const AutonDescriptor AUTONS[];
+extern const int AUTON_COUNT;
+
+// Descriptor for a selection, falling back to the first auton when out of range
+const AutonDescriptor& autonDescriptor(int selection);
+// Short label for the brain screen ("Left", "Skills", ...; empty for ANY)
+const char* autonSideName(AutonSide side);
+// Maps the auton selector pot reading to a selection, splitting its range evenly between the autons
+int autonFromPot(int potValue);
+
+// Feeds the current selection while disabled; prepares it once it has been stable for AUTON_SELECT_STABLE_TIME
+void updateAutonSelection(int selection);
+// True once `selection` has been prepared
+bool autonPrepared(int selection);
+// Where the robot was found at the start of autonomous
+struct StartDetection {
+    int selection;   // Auton to run
+    StartPose pose;  // In the auton's own (red) coordinates, ready for chassis.setPose()
+    bool matched;    // The distance sensors matched a start pose
+    bool overridden; // ...of a different auton than the pot selected
+};
+
+// Matches one snapshot of the four distance sensors against the start pose of every auton. The pot's selection wins
+// whenever it matches; otherwise a single clear match replaces it. With no match the selection and its descriptor
+// pose are kept. A relative selection (start at the origin) is kept as is, without checking or reporting anything.
+// Wall distances can't tell the alliances apart (the field is point-symmetric), so `red` still comes from the team
+// pot.
+StartDetection detectStart(int selection, bool red);
+
+// Prepares the selection if that hasn't happened yet, sets the start pose and runs it
+void runAuton(int selection, const StartPose& start);
+
+#endif
@@ -4,6 +4,8 @@
 #include "main.h"
 #include "lemlib/api.hpp"
 #include "pros/distance.hpp"
+#include "coroutines.hpp"
+#include "motion.hpp"
 #include <string>
 
 void auton1();
@@ -17,7 +19,18 @@ void auton8();
 void auton9();
 void auton10();
 
-void moveLinear(double inches, int timeout = 2000, float maxspeed = 70, float minspeed = 40);
+MotionHandle moveLinear(double inches, int timeout = 2000, float maxspeed = 70, float minspeed = 40);
 void chassisPID(std::string premade = "normal", double lat_kp = chassis.lateralPID.kP, double lat_ki = chassis.lateralPID.kI, double lat_kd = chassis.lateralPID.kD, double lat_slew = chassis.lateralPID.windupRange, double ang_kp = chassis.angularPID.kP, double ang_ki = chassis.angularPID.kI, double ang_kd = chassis.angularPID.kD);
 void resetOdometry(pros::Distance sensor1, std::string axis, double dist1_center);
+
+// Lookahead (inches) for path following; tunable at runtime (see params.hpp)
+extern float followLookahead;
+
+// --- Coroutine Autons ---
+// Runtime that resumes coroutine auton steps from the autonomous task (see coroutines.hpp)
+extern CoScheduler autonRuntime;
+// Waits until the current chassis motion has finished
+WaitAwaiter motionDone();
+// Waits until the current chassis motion has travelled `dist` inches or finished (like chassis.waitUntil)
+WaitAwaiter traveled(float dist);
 #endif
\ No newline at end of file
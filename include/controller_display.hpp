@@ -0,0 +1,52 @@
+#ifndef CONTROLLER_DISPLAY_HPP
+#define CONTROLLER_DISPLAY_HPP
+
+#include "main.h"
+#include <cstring>
+
+// --- Controller Display ---
+// The V5 controller accepts roughly one screen update every 50 ms; writes sent faster are dropped or delay each
+// other. Code sets lines here instead of calling controller.print(). A 3-line shadow buffer remembers what the screen
+// shows, and one background job sends at most one changed line per CONTROLLER_DISPLAY_PERIOD. When several lines are
+// waiting, the one with the highest priority goes first (ties go to whichever has waited longest).
+
+#define CONTROLLER_LINES 3
+#define CONTROLLER_COLUMNS 15
+
+class ControllerDisplay {
+    public:
+        // Replaces a whole line (cut or padded to the screen width). Safe from any task; nothing is sent if the
+        // text is unchanged.
+        void set(int line, const char* text);
+
+        template <typename... T> void print(int line, fmt::format_string<T...> format, T&&... args) {
+            char text[CONTROLLER_COLUMNS + 1];
+            auto result = fmt::format_to_n(text, CONTROLLER_COLUMNS, format, std::forward<T>(args)...);
+            text[result.size < CONTROLLER_COLUMNS ? result.size : CONTROLLER_COLUMNS] = '\0';
+            set(line, text);
+        }
+
+        // Higher priority lines are sent first (all start at 0)
+        void setPriority(int line, int priority);
+
+        // Sends the most urgent changed line. Registered as a background scheduler job.
+        void update();
+
+        // Transmissions so far (for checking the manager actually saves writes)
+        uint32_t sendCount() const { return sends; }
+    private:
+        struct Line {
+                char wanted[CONTROLLER_COLUMNS + 1] = {};
+                char shown[CONTROLLER_COLUMNS + 1] = {};
+                int priority = 0;
+                int waiting = 0; // Updates this line has been dirty for
+        };
+
+        pros::Mutex mutex;
+        Line lines[CONTROLLER_LINES];
+        uint32_t sends = 0;
+};
+
+extern ControllerDisplay controllerDisplay;
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef COROUTINES_HPP
+#define COROUTINES_HPP
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <vector>
+
+// --- Coroutine Runtime ---
+// Lets autonomous steps be written as straight-line code that still runs in parallel:
+//
+//     Routine intake() { ...; co_await sleepFor(500); ... }
+//     Routine auton() {
+//         autonRuntime.spawn(intake());    // runs alongside, no extra pros::Task
+//         chassis.moveToPoint(24, 24, 2000);
+//         co_await traveled(12);           // resumes once 12" into the motion
+//         co_await motionDone();
+//     }
+//
+// Every suspended routine is resumed from CoScheduler::tick(), so any number of them share one task and one stack.
+// The scheduler takes its clock and delay functions as parameters, so it has no PROS dependency and can run on a
+// host machine with simulated time.
+
+class CoScheduler;
+
+// A coroutine. It does nothing until it is spawned on a scheduler or co_awaited from another routine.
+class Routine {
+    public:
+        struct promise_type {
+                std::coroutine_handle<> continuation; // Routine waiting for this one to finish, if any
+
+                Routine get_return_object() { return Routine(Handle::from_promise(*this)); }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                // Hand control straight back to the awaiting routine (if any) when this one finishes
+                struct FinalAwaiter {
+                        bool await_ready() noexcept { return false; }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                            if (h.promise().continuation) return h.promise().continuation;
+                            return std::noop_coroutine();
+                        }
+
+                        void await_resume() noexcept {}
+                };
+
+                FinalAwaiter final_suspend() noexcept { return {}; }
+
+                void return_void() {}
+
+                void unhandled_exception() { std::terminate(); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Routine(Routine&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+
+        Routine& operator=(Routine&& other) noexcept;
+        Routine(const Routine&) = delete;
+        Routine& operator=(const Routine&) = delete;
+        ~Routine();
+
+        bool done() const { return !handle || handle.done(); }
+
+        // `co_await child()` runs the child to completion before continuing
+        auto operator co_await() && noexcept {
+            struct Awaiter {
+                    Handle child;
+
+                    bool await_ready() noexcept { return !child || child.done(); }
+
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept {
+                        child.promise().continuation = parent;
+                        return child;
+                    }
+
+                    void await_resume() noexcept {}
+            };
+
+            return Awaiter {handle};
+        }
+    private:
+        friend class CoScheduler;
+
+        explicit Routine(Handle handle) : handle(handle) {}
+
+        Handle handle;
+};
+
+// Suspends the calling routine until `ready` returns true or `wakeTime` passes
+struct WaitAwaiter {
+        std::function<bool()> ready; // Empty for a pure timed wait
+        uint32_t wakeTime;           // Absolute clock time
+        bool timed;                  // False to wait on `ready` alone
+
+        bool await_ready() { return ready && ready(); }
+
+        void await_suspend(std::coroutine_handle<> h);
+
+        void await_resume() {}
+};
+
+class CoScheduler {
+    public:
+        using ClockFn = uint32_t (*)();
+        using DelayUntilFn = void (*)(uint32_t* prevTime, uint32_t delta);
+
+        CoScheduler(ClockFn clock, DelayUntilFn delayUntil) : clock(clock), delayUntil(delayUntil) {}
+
+        // Starts a routine on the next tick (or later in the current tick if called from a routine)
+        void spawn(Routine routine);
+        // Resumes every routine whose wait condition is satisfied. A routine that suspends again during the tick waits
+        // for the next one, even with sleepFor(0).
+        void tick();
+        // True when every spawned routine has finished
+        bool idle() const { return routines.empty(); }
+        // Spawns `routine` and ticks every `period` ms until all routines have finished
+        void run(Routine routine, uint32_t period = 10);
+        // Destroys every routine without resuming it (e.g. when autonomous is cut short)
+        void clear();
+
+        uint32_t now() const { return clock(); }
+
+        // The scheduler currently ticking; awaitables park themselves here
+        static CoScheduler* current;
+    private:
+        friend struct WaitAwaiter;
+
+        struct Waiter {
+                std::coroutine_handle<> handle;
+                std::function<bool()> ready;
+                uint32_t wakeTime;
+                bool timed;
+                bool spawned = false; // Start of a routine from spawn(), not a routine that suspended
+        };
+
+        void park(Waiter waiter) { waiting.push_back(std::move(waiter)); }
+
+        ClockFn clock;
+        DelayUntilFn delayUntil;
+        std::vector<Routine> routines;
+        std::vector<Waiter> waiting;
+};
+
+// Waits for `ms` milliseconds
+WaitAwaiter sleepFor(uint32_t ms);
+// Waits until `condition` returns true, checked once per tick
+WaitAwaiter until(std::function<bool()> condition);
+// Waits until `condition` returns true or `timeout` ms pass, whichever comes first
+WaitAwaiter until(std::function<bool()> condition, uint32_t timeout);
+
+#endif
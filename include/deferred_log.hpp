@@ -0,0 +1,136 @@
+#ifndef DEFERRED_LOG_HPP
+#define DEFERRED_LOG_HPP
+
+#include "main.h"
+#include "robot_config.hpp"
+#include "ring_buffer.hpp"
+#include "lemlib/logger/message.hpp"
+#include "lemlib/logger/baseSink.hpp"
+#include <atomic>
+#include <type_traits>
+
+// --- Deferred Logging ---
+// LOG_INFO("pose {} {}", x, y) only copies the format string pointer and the raw argument values into a fixed-size
+// record in a per-task ring. A low-priority task does the fmt formatting later and hands the text to serialOut.
+// Like serialOut, the formatting task takes back the rings of deleted tasks.
+// Levels below LOG_COMPILE_LEVEL (robot_config.hpp) compile to nothing, arguments included.
+//
+// Arguments must be numbers, bools, chars or string literals / other strings that outlive the call: only the
+// pointer of a `const char*` is captured.
+
+#define LOG_MAX_ARGS 6
+
+struct LogRecord {
+    const char* format; // Also identifies the call site
+    uint32_t time;
+    uint8_t level;
+    uint8_t count;
+    uint8_t types[LOG_MAX_ARGS];
+    union Arg {
+        int64_t i;
+        uint64_t u;
+        double f;
+        const char* s;
+        const void* p;
+    } args[LOG_MAX_ARGS];
+};
+
+class DeferredLog {
+    public:
+        enum ArgType : uint8_t { INT, UINT, FLOAT, BOOL, CHAR, STRING, POINTER };
+
+        // Starts the formatting task
+        void start();
+
+        // Captures one record. Prefer the LOG_* macros, which also strip disabled levels at compile time.
+        template <typename... T> void log(lemlib::Level level, fmt::format_string<T...> format, T&&... args) {
+            static_assert(sizeof...(T) <= LOG_MAX_ARGS, "too many log arguments");
+            LogRecord record;
+            record.format = format.get().data();
+            record.time = pros::millis();
+            record.level = static_cast<uint8_t>(level);
+            record.count = 0;
+            (capture(record, args), ...);
+            push(record);
+        }
+
+        // Gives up the calling task's ring once its records have been formatted. Call last in a task that is about
+        // to return (the startup steps) to free its ring right away rather than once the task is gone.
+        void releaseTask();
+
+        uint32_t dropCount() const;
+    private:
+        template <typename T> static void capture(LogRecord& record, const T& value) {
+            using U = std::decay_t<T>;
+            LogRecord::Arg& arg = record.args[record.count];
+            uint8_t& type = record.types[record.count++];
+            if constexpr (std::is_same_v<U, bool>) {
+                arg.u = value;
+                type = BOOL;
+            } else if constexpr (std::is_same_v<U, char>) {
+                arg.i = value;
+                type = CHAR;
+            } else if constexpr (std::is_floating_point_v<U>) {
+                arg.f = value;
+                type = FLOAT;
+            } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+                arg.i = value;
+                type = INT;
+            } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+                arg.u = static_cast<uint64_t>(value);
+                type = UINT;
+            } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+                arg.s = value;
+                type = STRING;
+            } else {
+                static_assert(std::is_pointer_v<U>, "deferred log arguments must be numbers or static strings");
+                arg.p = value;
+                type = POINTER;
+            }
+        }
+
+        void push(const LogRecord& record);
+        void formatLoop();
+
+        struct Producer {
+                std::atomic<pros::task_t> task = nullptr;
+                std::atomic<bool> released = false; // The owner has exited; free the ring once it is empty
+                SpscRing<LOG_RING_SIZE> ring;
+        };
+
+        Producer producers[LOG_MAX_PRODUCERS];
+        std::atomic<uint32_t> unclaimedDrops = 0;
+};
+
+extern DeferredLog deferredLog;
+
+#define LOG_LEVEL_INFO 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_FATAL 4
+
+// Same level order as lemlib::Level
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) deferredLog.log(lemlib::Level::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) deferredLog.log(lemlib::Level::DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) deferredLog.log(lemlib::Level::WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) deferredLog.log(lemlib::Level::ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+#define LOG_FATAL(...) deferredLog.log(lemlib::Level::FATAL, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef DEVICE_STATE_HPP
+#define DEVICE_STATE_HPP
+
+#include "main.h"
+#include "snapshot.hpp"
+
+// --- Device State ---
+// Every smart-port and ADI device is read once per DEVICE_UPDATE_PERIOD into one struct.
+// Consumers read `deviceState.load()` instead of calling the PROS device functions themselves, so each value is
+// fetched once per tick and every reader sees the same time-aligned view of the robot.
+
+struct MotorState {
+    float position = 0;    // Degrees (motor encoder units as configured)
+    float velocity = 0;    // RPM
+    float temperature = 0; // Degrees C
+    int32_t voltage = 0;   // mV
+    int32_t current = 0;   // mA
+};
+
+struct DistanceState {
+    int32_t distance = 0;   // mm (9999 when nothing is in range)
+    int32_t confidence = 0; // 0-63
+};
+
+struct ControllerState {
+    int8_t leftX = 0;
+    int8_t leftY = 0;
+    int8_t rightX = 0;
+    int8_t rightY = 0;
+    uint16_t buttons = 0; // Bit n set when digital button (E_CONTROLLER_DIGITAL_L1 + n) is held
+
+    bool pressed(pros::controller_digital_e_t button) const {
+        return buttons & (1u << (button - pros::E_CONTROLLER_DIGITAL_L1));
+    }
+};
+
+struct DeviceState {
+    MotorState left[3];
+    MotorState right[3];
+
+    int32_t horizontalPosition = 0; // Centidegrees
+    int32_t horizontalVelocity = 0; // Centidegrees per second
+    int32_t verticalPosition = 0;   // Centidegrees
+    int32_t verticalVelocity = 0;   // Centidegrees per second
+
+    float imuRotation = 0; // Degrees, unbounded
+    float imuHeading = 0;  // Degrees, 0-360
+    float imuPitch = 0;
+    float imuRoll = 0;
+    float imuGyroZ = 0;    // Degrees per second
+    float imuAccelX = 0;   // g
+    float imuAccelY = 0;   // g
+
+    DistanceState rightDist;
+    DistanceState leftDist;
+    DistanceState frontDist;
+    DistanceState backDist;
+
+    int32_t autonPot = 0;   // Raw ADI value
+    float teamPotAngle = 0; // Degrees
+
+    ControllerState master;
+
+    float batteryCapacity = 0; // Percent
+    int32_t batteryVoltage = 0; // mV
+
+    uint32_t time = 0;   // pros::millis() when the read started
+    uint32_t update = 0; // Increments on every publish
+
+    // Average temperature of all six drivetrain motors
+    float driveTemperature() const {
+        float sum = 0;
+        for (int i = 0; i < 3; i++) sum += left[i].temperature + right[i].temperature;
+        return sum / 6;
+    }
+};
+
+extern Snapshot<DeviceState> deviceState;
+
+// Reads every device once and publishes the result. Registered as a scheduler job.
+void updateDeviceState();
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef DRIVE_CURVES_HPP
+#define DRIVE_CURVES_HPP
+
+#include "lemlib/chassis/chassis.hpp"
+#include <cstddef>
+
+// --- Drive Curves ---
+// Driver input shaping through 256-entry lookup tables, so chassis.arcade() does one load per stick instead of
+// evaluating pow(). Tables are built from a CurveShape when a driver profile is selected or a curve parameter changes.
+//
+// Every shape maps |input| past the deadband to t in [0, 1], shapes it to s in [0, 1], and outputs
+// sign(input) * (minOutput + (127 - minOutput) * s). Expo with the same deadband/minOutput/gain matches
+// lemlib::ExpoDriveCurve.
+
+enum class CurveType {
+    EXPO,   // s = t * gain^((127 - deadband) * (t - 1))
+    LINEAR, // Straight lines between `points`
+    SPLINE, // Monotone cubic through `points` (no overshoot between points)
+};
+
+// One control point of a LINEAR or SPLINE shape, both coordinates in [0, 1]. (0, 0) and (1, 1) are implied.
+struct CurvePoint {
+    float in, out;
+};
+
+#define CURVE_MAX_POINTS 6
+
+struct CurveShape {
+    CurveType type = CurveType::EXPO;
+    float deadband = 0;  // Stick units ignored around zero
+    float minOutput = 0; // Output just past the deadband
+    float gain = 1;      // EXPO only
+    CurvePoint points[CURVE_MAX_POINTS] = {};
+    size_t pointCount = 0;
+
+    // Evaluates the shape directly (used to fill tables)
+    float evaluate(float input) const;
+};
+
+class TableDriveCurve : public lemlib::DriveCurve {
+    public:
+        explicit TableDriveCurve(const CurveShape& shape) { build(shape); }
+
+        // Refills the table. Not synchronized with curve(); call from the task that drives the chassis.
+        void build(const CurveShape& shape);
+
+        float curve(float input) override;
+    private:
+        float table[256]; // Index = input + 128, covering -128..127
+};
+
+// A named pair of throttle and steer shapes
+struct DriverProfile {
+    const char* name;
+    CurveShape throttle;
+    CurveShape steer;
+};
+
+// Curves the chassis uses during driver control
+extern TableDriveCurve throttleTable;
+extern TableDriveCurve steerTable;
+
+int driverProfileCount();
+const char* driverProfileName(int index);
+int activeDriverProfile();
+// Loads a profile's shapes and rebuilds both tables
+void selectDriverProfile(int index);
+// Working copy of the active profile; rebuildDriveCurves() after editing it
+DriverProfile& editDriverProfile();
+void rebuildDriveCurves();
+// Registers the profile index and the active profile's deadband/minOutput/gain as live parameters (params.hpp)
+void registerDriveCurveParams();
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef DRIVER_CONTROL_HPP
+#define DRIVER_CONTROL_HPP
+
+#include "main.h"
+#include "snapshot.hpp"
+
+// --- Driver Control Pipeline ---
+// opcontrol() runs at the device update rate (DRIVE_LOOP_PERIOD) with delay_until, so every motor command cycle gets
+// a fresh stick sample instead of beating against a slower loop. Each sample is timestamped when it is read and
+// again when the chassis command built from it has been issued, giving two latency figures:
+//   command latency  sample read -> command issued (time spent in the loop body)
+//   stick latency    stick movement -> command issued; a movement is placed halfway between the sample that first
+//                    saw it and the one before, so this includes the sampling delay the loop rate adds
+
+struct DriverSample {
+    int throttle = 0; // Left stick Y
+    int turn = 0;     // Right stick X
+    uint16_t buttons = 0; // Held digital buttons, same bit layout as ControllerState::buttons
+    uint32_t time = 0; // pros::micros() when the sticks were read
+};
+
+struct DriverLatency {
+    uint32_t samples = 0;
+    uint32_t changes = 0;   // Samples where a stick had moved
+    float commandMean = 0;  // us
+    uint32_t commandMax = 0;
+    float stickMean = 0;    // us
+    uint32_t stickMax = 0;
+};
+
+// Running totals since the last startDriverControl()
+extern Snapshot<DriverLatency> driverLatency;
+
+// Resets the latency totals at the start of driver control
+void startDriverControl();
+// Reads and timestamps the sticks and buttons
+DriverSample readDriverSample();
+// Records that the command built from `sample` has just been issued
+void driverCommandIssued(const DriverSample& sample);
+// Logs the latency totals. Registered as a background scheduler job.
+void reportDriverLatency();
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef FLIGHT_LOG_HPP
+#define FLIGHT_LOG_HPP
+
+#include "telemetry_format.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// --- Flight Log Format ---
+// On-disk layout written by FlightRecorder (flight_recorder.hpp); standard library only so host tools can read it.
+//
+// A run is one file, run_NNNN.kfr:
+//   [FlightHeader, padded to FLIGHT_HEADER_SIZE]
+//   [block 0][block 1]...  each FLIGHT_BLOCK_SIZE bytes: FlightBlockHeader + packed records + zero padding
+// A record is [type:u8][size:u8][time:u32][payload:size bytes], unaligned.
+// Blocks carry a sequence number and CRC, so a file cut off by a crash or power loss is still readable up to the
+// last complete block; `finalized` in the header tells whether the run was closed cleanly.
+
+#define FLIGHT_MAGIC 0x52464B4B       // "KKFR"
+#define FLIGHT_BLOCK_MAGIC 0x4B4C4246 // "FBLK"
+#define FLIGHT_VERSION 1
+#define FLIGHT_HEADER_SIZE 512
+#define FLIGHT_BLOCK_SIZE 4096
+#define FLIGHT_RECORD_HEADER 6
+
+struct FlightHeader {
+    uint32_t magic = FLIGHT_MAGIC;
+    uint16_t version = FLIGHT_VERSION;
+    uint16_t headerSize = FLIGHT_HEADER_SIZE;
+    uint32_t blockSize = FLIGHT_BLOCK_SIZE;
+    uint32_t runIndex = 0;  // Increments across runs (kept in runs.idx next to the logs)
+    uint32_t startTime = 0; // pros::millis() when recording started
+    uint8_t auton = 0;      // selectedAuton, 0 for driver control
+    uint8_t red = 0;
+    uint8_t finalized = 0;  // 1 once the run was closed cleanly
+    uint8_t reserved = 0;
+    uint32_t blocks = 0;    // Blocks written so far (rewritten as the run goes)
+    uint32_t records = 0;   // Records written so far
+    uint32_t drops = 0;     // Records dropped because both RAM buffers were full
+};
+
+struct FlightBlockHeader {
+    uint32_t magic = FLIGHT_BLOCK_MAGIC;
+    uint32_t sequence = 0; // Block number within the run
+    uint32_t used = 0;     // Record bytes in this block after the header
+    uint32_t records = 0;
+    uint32_t crc = 0;      // CRC-32 of the record bytes
+};
+
+enum FlightRecordType : uint8_t {
+    FLIGHT_POSE = 1,   // PoseSample
+    FLIGHT_MOTORS = 2, // MotorSample
+    FLIGHT_PID = 3,    // PidSample
+    FLIGHT_MOTION = 4, // MotionEvent
+};
+
+// Every drive motor, left 1-3 then right 1-3
+struct MotorSample {
+    float velocity[6]; // RPM
+    int16_t voltage[6]; // mV
+    int16_t current[6]; // mA
+};
+
+// Which chassis function a motion came from
+enum MotionKind : uint8_t {
+    MOTION_TURN_TO_POINT = 1,
+    MOTION_TURN_TO_HEADING = 2,
+    MOTION_SWING_TO_HEADING = 3,
+    MOTION_SWING_TO_POINT = 4,
+    MOTION_MOVE_TO_POSE = 5,
+    MOTION_MOVE_TO_POINT = 6,
+    MOTION_FOLLOW = 7,
+};
+
+enum MotionPhase : uint8_t { MOTION_START = 0, MOTION_END = 1 };
+
+// Logged when a motion handle starts and when its motion ends
+struct MotionEvent {
+    uint32_t id;        // Increments per motion since boot
+    uint8_t kind;       // MotionKind
+    uint8_t phase;      // MotionPhase
+    uint8_t cancelled;  // End events only: stopped through MotionHandle::cancel()
+    uint8_t reserved;
+    float targetX, targetY, targetTheta; // NaN where the motion has no such target
+    int32_t timeout;    // ms
+    float progress;     // End events only: distance travelled (inches, or degrees for turns)
+};
+
+// CRC-32 (IEEE)
+uint32_t crc32(const uint8_t* data, size_t length);
+
+// Reads a run file record by record, stopping at the first damaged or missing block
+class FlightLogReader {
+    public:
+        ~FlightLogReader();
+
+        // Opens a run and reads its header. Returns false if the file is missing or not a flight log.
+        bool open(const char* path);
+        // Fetches the next record. `payload` must hold 255 bytes. Returns false at the end of the readable data.
+        bool next(uint8_t& type, uint32_t& time, uint8_t* payload, uint8_t& size);
+
+        const FlightHeader& header() const { return head; }
+
+        // Blocks that were read and passed their CRC
+        uint32_t blocksRead() const { return blockCount; }
+    private:
+        bool loadBlock();
+
+        std::FILE* file = nullptr;
+        FlightHeader head;
+        uint8_t block[FLIGHT_BLOCK_SIZE];
+        size_t offset = 0; // Read position within the current block's records
+        size_t used = 0;
+        uint32_t blockCount = 0;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include "flight_log.hpp"
+#include <atomic>
+#include <cstdio>
+#include <type_traits>
+
+// --- Flight Recorder ---
+// Writes a run of high-rate records (flight_log.hpp) to storage without blocking the loop that produces them.
+// One producer task appends records into a RAM block; when the block fills it is sealed and the producer moves on to
+// the next one while a background task writes the sealed block out as a single FLIGHT_BLOCK_SIZE write. Standard
+// library only: the robot points it at /usd, host tests at any directory.
+//
+// Producer side: append(), stop(). Consumer side: open(), flush(). Each side must stay on one task.
+
+#define FLIGHT_BUFFERS 2 // RAM blocks; two lets one fill while the other is written
+
+class FlightRecorder {
+    public:
+        // Starts a new run in `directory`, numbered from <directory>/runs.idx. Returns false if the file can't be
+        // created. Must not be called while a run is still open.
+        bool open(const char* directory, uint32_t startTime, uint8_t auton, bool red);
+        // Writes every sealed block, and closes the run once stop() has sealed the last one.
+        void flush();
+
+        // Adds a record to the current block. Returns false (and counts a drop) when not recording or when every
+        // block is still waiting to be written.
+        bool append(uint8_t type, uint32_t time, const void* payload, uint8_t size);
+
+        template <typename T> bool append(uint8_t type, uint32_t time, const T& payload) {
+            static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= 255);
+            return append(type, time, &payload, sizeof(T));
+        }
+
+        // Seals the partly filled block and ends the run; the next flush() writes it and finalizes the file.
+        void stop();
+
+        bool isRecording() const { return recording.load(std::memory_order_acquire); }
+
+        // True from open() until flush() has finalized the run
+        bool isOpen() const { return file != nullptr; }
+
+        uint32_t runIndex() const { return header.runIndex; }
+
+        uint32_t dropCount() const { return drops.load(std::memory_order_relaxed); }
+    private:
+        struct Block {
+            std::atomic<bool> sealed = false; // Set by the producer, cleared by the consumer once written
+            uint32_t used = sizeof(FlightBlockHeader);
+            uint32_t records = 0;
+            alignas(4) uint8_t data[FLIGHT_BLOCK_SIZE];
+        };
+
+        bool writeHeader();
+        void writeBlock(Block& block);
+        void finalize();
+
+        Block blocks[FLIGHT_BUFFERS];
+        size_t fill = 0;  // Block the producer is appending to
+        size_t drain = 0; // Next block the consumer writes
+        std::atomic<bool> recording = false;
+        std::atomic<bool> stopped = false;
+        std::atomic<uint32_t> drops = 0;
+
+        std::FILE* file = nullptr;
+        FlightHeader header;
+};
+
+#endif
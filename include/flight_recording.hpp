@@ -0,0 +1,23 @@
+#ifndef FLIGHT_RECORDING_HPP
+#define FLIGHT_RECORDING_HPP
+
+#include "main.h"
+#include "flight_recorder.hpp"
+
+// --- Flight Recording ---
+// Records pose, motor velocities/voltages/currents, PID terms and motion start/end events at FLIGHT_RECORD_PERIOD to
+// /usd/run_NNNN.kfr during every match phase. Dump a run on the host with tools/flightlog_dump, or summarize it with
+// tools/flightlog_report.
+
+extern FlightRecorder flightRecorder;
+
+// Starts the writer task. Call once from initialize().
+void startFlightRecorder();
+// Begins a new run, ending the current one first. `auton` is 0 for driver control.
+void startFlightRecording(uint8_t auton, bool red);
+// Ends the current run; the writer task finalizes the file shortly after.
+void stopFlightRecording();
+// Appends the records for this tick. Registered as a scheduler job; the only task that appends to flightRecorder.
+void recordFlightData();
+
+#endif
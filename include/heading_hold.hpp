@@ -0,0 +1,26 @@
+#ifndef HEADING_HOLD_HPP
+#define HEADING_HOLD_HPP
+
+#include "main.h"
+#include "driver_control.hpp"
+
+// --- Heading Hold ---
+// Opt-in driver assist that keeps the robot straight while the driver pushes forward or back. With the turn stick
+// inside HOLD_TURN_DEADBAND and throttle applied, it latches the heading once the robot has stopped rotating and steers
+// back to it with a PID. Any turn input releases it on the same loop iteration, and the correction is capped at
+// HOLD_MAX_TURN so it can never out-steer the driver.
+
+// Turns the assist on or off (starts as HEADING_HOLD_DEFAULT)
+void setHeadingHold(bool enabled);
+bool headingHoldEnabled();
+// True while a heading is latched and being corrected
+bool headingHoldActive();
+
+// Drives the chassis for one opcontrol() iteration, through heading hold when it applies and chassis.arcade()
+// otherwise
+void driveWithAssist(const DriverSample& sample);
+
+// Registers the hold gains and on/off switch as live parameters (params.hpp)
+void registerHeadingHoldParams();
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef INPUT_LOG_HPP
+#define INPUT_LOG_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// --- Input Log Format ---
+// Binary record of every input the control stack consumes, one record per device update.
+// This header only depends on the standard library so host-side replay tools can include it.
+// File layout: one InputLogHeader followed by `count` InputRecords, all little-endian.
+
+#define INPUT_LOG_MAGIC 0x4C494B4B // "KKIL"
+#define INPUT_LOG_VERSION 1
+
+struct InputLogHeader {
+    uint32_t magic = INPUT_LOG_MAGIC;
+    uint16_t version = INPUT_LOG_VERSION;
+    uint16_t recordSize = 0; // sizeof(InputRecord) when written
+    uint32_t period = 0;     // Milliseconds between records
+    uint32_t count = 0;      // Number of records that follow
+    uint8_t auton = 0;       // selectedAuton when recording started (0 for driver control)
+    uint8_t red = 0;         // 1 if teamtype was RED
+    uint16_t reserved = 0;
+};
+
+struct InputRecord {
+    uint32_t time;                // pros::millis()
+    int32_t horizontalPosition;   // Rotation sensor, centidegrees
+    int32_t verticalPosition;     // Rotation sensor, centidegrees
+    int32_t leftMotorPosition[3]; // Motor encoders, centidegrees
+    int32_t rightMotorPosition[3];
+    float imuRotation;  // Degrees, unbounded
+    float imuHeading;   // Degrees, 0-360
+    float imuGyroZ;     // Degrees per second
+    int16_t distance[4]; // mm: right, left, front, back
+    int8_t sticks[4];    // leftX, leftY, rightX, rightY
+    uint16_t buttons;    // Same bit layout as ControllerState::buttons
+    uint16_t reserved;
+};
+
+static_assert(sizeof(InputLogHeader) == 20, "InputLogHeader layout is part of the file format");
+static_assert(sizeof(InputRecord) == 64, "InputRecord layout is part of the file format");
+
+// Writes a complete log. Returns false if the file could not be written.
+bool writeInputLog(const char* path, InputLogHeader header, const std::vector<InputRecord>& records);
+
+// Reads a complete log. Returns false if the file is missing, truncated or from an incompatible version.
+bool readInputLog(const char* path, InputLogHeader& header, std::vector<InputRecord>& records);
+
+#endif
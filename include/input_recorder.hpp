@@ -0,0 +1,27 @@
+#ifndef INPUT_RECORDER_HPP
+#define INPUT_RECORDER_HPP
+
+#include "main.h"
+#include "device_state.hpp"
+#include "input_log.hpp"
+
+// --- Input Recorder ---
+// Captures every device snapshot into RAM while a match phase runs and writes it to the SD card afterwards.
+// The resulting log can be replayed on a host machine to re-run the control code against real sensor data
+// (host/build/robot_host --replay inputs_NNN.bin).
+
+// Starts a new recording, discarding anything not yet saved. `auton` is 0 for driver control.
+void startInputRecording(uint8_t auton, bool red);
+// Stops recording and writes /usd/inputs_NNN.bin under the next unused number. Does nothing if no recording is active;
+// saves nothing (with a log line) before scanInputLogs() has run or once every number is taken.
+void stopInputRecording();
+// Finds the first unused log number on the SD card. Runs once at startup (STARTUP_DEVICES), so saving a run costs
+// no directory probing.
+void scanInputLogs();
+// Appends the latest device snapshot. Registered as a scheduler job at the device update rate.
+void recordInputs();
+
+// Packs a device snapshot into the on-disk record layout
+InputRecord makeInputRecord(const DeviceState& state);
+
+#endif
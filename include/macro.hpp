@@ -0,0 +1,42 @@
+#ifndef MACRO_HPP
+#define MACRO_HPP
+
+#include "main.h"
+#include "driver_control.hpp"
+#include "macro_format.hpp"
+#include "robot_config.hpp"
+
+// --- Driver Macros ---
+// Records driver control (sticks, buttons and pose per drive loop iteration) into RAM, and plays it back by
+// re-driving chassis.arcade() and subsystemControl() while steering toward the recorded pose trace
+// (macroStep() in macro_format.hpp). The recording is saved to MACRO_PATH when the robot is disabled and loaded back
+// from it at startup (STARTUP_PATHS). opcontrol() plays it a frame per loop iteration; autons call playMacro().
+
+// Starts a new recording from the current pose, discarding the previous one
+void startMacroRecording();
+void stopMacroRecording();
+bool macroRecording();
+// Appends one frame. Call once per drive loop iteration while recording.
+void recordMacroFrame(const DriverSample& sample);
+
+// Writes the recording to `path` (does nothing if there is none)
+bool saveMacro(const char* path = MACRO_PATH);
+// Replaces the recording with the macro in `path`
+bool loadMacro(const char* path = MACRO_PATH);
+// Frames in the recording (0 when there is none)
+size_t macroFrameCount();
+
+// Starts playing the recording back (returns false if there is none). With `resetPose` the chassis pose is set to the
+// recorded start first; otherwise the robot must already be on it.
+bool startMacroPlayback(bool resetPose = true);
+// Stops playback early, releasing the drive and subsystems
+void stopMacroPlayback();
+bool macroPlaying();
+// Drives the next recorded frame. Call once per drive loop iteration, in place of driver control; returns false once
+// playback has ended (or was never started), and the loop drives as usual again.
+bool macroPlaybackStep();
+// Plays the whole recording from this task, blocking until it ends; for autons, with no chassis motion running.
+// Returns false if there is none.
+bool playMacro(bool resetPose = true);
+
+#endif
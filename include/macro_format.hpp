@@ -0,0 +1,70 @@
+#ifndef MACRO_FORMAT_HPP
+#define MACRO_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Driver Macro Format ---
+// A recorded stretch of driver control: the sticks and buttons of every drive loop iteration, with the odometry pose
+// at that moment so playback can steer back onto the recorded trace. Standard library only, so playback can be
+// checked in a host simulation.
+// File layout: one MacroHeader followed by `count` MacroFrames, all little-endian.
+
+#define MACRO_MAGIC 0x434D4B4B // "KKMC"
+#define MACRO_VERSION 1
+
+struct MacroHeader {
+    uint32_t magic = MACRO_MAGIC;
+    uint16_t version = MACRO_VERSION;
+    uint16_t period = 0;  // Milliseconds between frames
+    uint32_t count = 0;   // Number of frames that follow
+    uint8_t profile = 0;  // Driver profile (drive_curves.hpp) the sticks were shaped with
+    uint8_t reserved[3] = {};
+    float startX = 0, startY = 0, startTheta = 0; // Pose when recording started
+};
+
+struct MacroFrame {
+    int8_t throttle;  // Left stick Y
+    int8_t turn;      // Right stick X
+    uint16_t buttons; // Same bit layout as ControllerState::buttons
+    int16_t x, y;     // Pose, hundredths of an inch
+    int16_t theta;    // Heading, tenths of a degree
+};
+
+static_assert(sizeof(MacroHeader) == 28, "MacroHeader layout is part of the file format");
+static_assert(sizeof(MacroFrame) == 10, "MacroFrame layout is part of the file format");
+
+MacroFrame makeMacroFrame(int throttle, int turn, uint16_t buttons, float x, float y, float theta);
+
+inline float frameX(const MacroFrame& frame) { return frame.x / 100.0f; }
+
+inline float frameY(const MacroFrame& frame) { return frame.y / 100.0f; }
+
+inline float frameTheta(const MacroFrame& frame) { return frame.theta / 10.0f; }
+
+// How hard playback pulls back onto the recorded trace
+struct MacroGains {
+    float along = 4;     // Throttle per inch the robot is behind (or ahead of) the recorded pose
+    float lateral = 3;   // Turn per inch the recorded pose is off to the side
+    float heading = 1.5; // Turn per degree of heading error
+    size_t lookahead = 5; // Frames ahead of the current one to steer toward
+};
+
+struct MacroCommand {
+    int throttle;
+    int turn;
+};
+
+// Stick values for frame `index`: the recorded sticks plus a correction toward the recorded pose trace, given the
+// robot's current pose (LemLib convention: heading in degrees, clockwise from +y)
+MacroCommand macroStep(const std::vector<MacroFrame>& frames, size_t index, float x, float y, float theta,
+                       const MacroGains& gains);
+
+// Writes a complete macro. Returns false if the file could not be written.
+bool writeMacro(const char* path, MacroHeader header, const std::vector<MacroFrame>& frames);
+// Reads a complete macro. Returns false if the file is missing, truncated, from an incompatible version or longer
+// than `maxFrames` (checked before anything is allocated).
+bool readMacro(const char* path, MacroHeader& header, std::vector<MacroFrame>& frames, size_t maxFrames);
+
+#endif
@@ -88,6 +88,8 @@ extern pros::Distance rightDistance;
 extern pros::Distance leftDistance;
 extern pros::Distance frontDistance;
 extern pros::Distance backDistance;
+extern pros::adi::Potentiometer autonSelector;
+extern pros::adi::Potentiometer teamSelector;
 extern int selectedAuton;
 extern std::string teamtype;
 #endif
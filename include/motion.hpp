@@ -0,0 +1,71 @@
+#ifndef MOTION_HPP
+#define MOTION_HPP
+
+#include "main.h"
+#include "lemlib/api.hpp"
+#include "coroutines.hpp"
+#include "flight_log.hpp"
+#include <atomic>
+#include <memory>
+
+// --- Motion Handles ---
+// Wrappers around the async chassis motions that return a handle for the motion they started:
+//
+//     MotionHandle drive = motion::moveToPoint(24, 24, 2000);
+//     drive.wait();          // blocks this task on a notification, no polling loop
+//     co_await drive;        // or from a coroutine auton
+//     drive.cancel();        // from any task
+//
+// One monitor job watches the chassis and notifies every task blocked on a handle as soon as its motion ends.
+
+struct MotionState;
+
+class MotionHandle {
+    public:
+        MotionHandle() = default;
+
+        // True once the motion has finished, timed out or been cancelled
+        bool done() const;
+        // True if the motion was stopped through cancel()
+        bool cancelled() const;
+        // Distance travelled so far (inches, or degrees for turns); the final value once done
+        float progress() const;
+        // Milliseconds from start to finish (or to now if still running)
+        uint32_t elapsed() const;
+        // Stops the motion if it is still running. Safe to call from any task.
+        void cancel();
+        // Blocks the calling task until the motion ends or `timeout` ms pass. Returns true if the motion ended.
+        bool wait(uint32_t timeout = TIMEOUT_MAX) const;
+        // Blocks until the motion has travelled `dist` or ended. Returns true if the distance was reached.
+        bool waitUntil(float dist, uint32_t timeout = TIMEOUT_MAX) const;
+
+        // `co_await handle` from a coroutine auton waits for the motion to end
+        WaitAwaiter operator co_await() const;
+    private:
+        friend MotionHandle startMotion(MotionKind kind, float x, float y, float theta, int timeout);
+
+        explicit MotionHandle(std::shared_ptr<MotionState> state) : state(std::move(state)) {}
+
+        std::shared_ptr<MotionState> state;
+};
+
+// Checks the running motion and wakes waiters. Registered as a scheduler job.
+void updateMotionHandles();
+
+// Copies up to `max` start/end events newer than `sequence` into `out` (with their pros::millis() times in `times`)
+// and advances `sequence`. Only the last 16 events are kept; a reader that falls further behind skips the oldest.
+size_t readMotionEvents(uint32_t& sequence, MotionEvent* out, uint32_t* times, size_t max);
+
+namespace motion {
+MotionHandle turnToPoint(float x, float y, int timeout, lemlib::TurnToPointParams params = {});
+MotionHandle turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params = {});
+MotionHandle swingToHeading(float theta, lemlib::DriveSide lockedSide, int timeout,
+                            lemlib::SwingToHeadingParams params = {});
+MotionHandle swingToPoint(float x, float y, lemlib::DriveSide lockedSide, int timeout,
+                          lemlib::SwingToPointParams params = {});
+MotionHandle moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params = {});
+MotionHandle moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params = {});
+MotionHandle follow(const asset& path, float lookahead, int timeout, bool forwards = true);
+} // namespace motion
+
+#endif
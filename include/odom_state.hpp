@@ -0,0 +1,29 @@
+#ifndef ODOM_STATE_HPP
+#define ODOM_STATE_HPP
+
+#include "main.h"
+#include "lemlib/api.hpp"
+#include "snapshot.hpp"
+
+// --- Odometry State ---
+// Full odometry state captured once per odometry tick. Read it through `odomState.load()` instead of calling
+// chassis.getPose() repeatedly; every field comes from the same update and readers never take the chassis lock.
+struct OdomState {
+    float x = 0;         // Inches
+    float y = 0;         // Inches
+    float theta = 0;     // Degrees
+    float xVel = 0;      // Inches per second, field frame
+    float yVel = 0;      // Inches per second, field frame
+    float thetaVel = 0;  // Degrees per second
+    uint32_t time = 0;   // pros::millis() when the state was captured
+    uint32_t update = 0; // Increments on every publish
+
+    lemlib::Pose pose() const { return lemlib::Pose(x, y, theta); }
+};
+
+extern Snapshot<OdomState> odomState;
+
+// Reads the chassis once and publishes the result. Registered as a scheduler job at the odometry rate.
+void publishOdomState();
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef PARAMS_HPP
+#define PARAMS_HPP
+
+#include "main.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// --- Live Parameters ---
+// Tunable values (gains, exit thresholds, lookahead, drive curve) registered by name and id, and changed at runtime
+// over the serial line with tools/param_cli instead of rebuilding and re-uploading.
+//
+// Changes are staged, then committed as a batch; a committed batch is only written into the live values at a loop
+// boundary (see ParamBoundary), so a running loop never sees half of a set of gains. Once applied, a committed value
+// also takes priority over presets set from code (preset()) for the rest of the run.
+//
+// Serial protocol, one command per line on the robot's stdin; replies are lines starting with '$':
+//   L              list        -> "$P <id> <name> <value> <min> <max>" per parameter, then "$E"
+//   G <id|name>    get         -> "$V <id> <value>"
+//   S <id|name> v  stage       -> "$S <id> <v>"
+//   C              commit      -> "$C <count>" (parameters that will apply at their next boundary)
+// Errors reply "$ERR <reason>".
+
+#define PARAM_MAX 48
+
+// Where committed values of a parameter are applied
+enum class ParamBoundary {
+    MOTION, // Between chassis motions: when one starts on an idle chassis, or when the motion monitor sees one hand
+            // over to the next (LemLib reads gains and exit conditions inside its motion loop)
+    DRIVER, // At the top of an opcontrol() loop iteration
+};
+
+class ParamRegistry {
+    public:
+        // Registers `value` under `name`; returns its id (-1 when the table is full). `onApply` runs after a
+        // committed change has been written to `value`. Register everything in initialize(), before tasks start.
+        int add(const char* name, float* value, float min, float max, ParamBoundary boundary,
+                std::function<void()> onApply = nullptr);
+
+        // Looks up a parameter by name or by decimal id; -1 if there is none
+        int find(const char* key) const;
+
+        // Stages a value; false if the id is unknown or the value is outside [min, max]
+        bool stage(int id, float value);
+        // Marks every staged value as ready; returns how many there were
+        int commit();
+        // Writes committed values for `boundary` into their live variables. Call only from that boundary.
+        void apply(ParamBoundary boundary);
+        // Sets a value from code (e.g. a gain preset in chassisPID()), unless a committed value has been applied to
+        // it. Returns false if `name` is unknown.
+        bool preset(const char* name, float value);
+
+        int size() const { return count; }
+
+        const char* name(int id) const { return params[id].name; }
+
+        float value(int id) const { return *params[id].value; }
+
+        float min(int id) const { return params[id].min; }
+
+        float max(int id) const { return params[id].max; }
+    private:
+        enum State : uint8_t { CLEAN, STAGED, COMMITTED };
+
+        struct Param {
+                const char* name = nullptr;
+                float* value = nullptr;
+                float min = 0, max = 0;
+                ParamBoundary boundary = ParamBoundary::MOTION;
+                std::function<void()> onApply;
+                std::atomic<float> staged = 0;
+                std::atomic<uint8_t> state = CLEAN;
+                std::atomic<bool> tuned = false; // A committed value has been applied; presets leave it alone
+        };
+
+        Param params[PARAM_MAX];
+        int count = 0;
+};
+
+extern ParamRegistry params;
+
+// Registers the robot's tunable values. Called once from initialize().
+void registerParams();
+// Starts the task that reads commands from stdin
+void startParamServer();
+// Applies committed MOTION parameters if no motion is running. Called by the motion:: wrappers (motion.hpp) right
+// before they start a motion, from the task that starts it, so no motion can begin between the check and the apply.
+// Chained motions never leave the chassis idle; the motion monitor applies those at the handoff instead.
+void applyMotionParams();
+
+#endif
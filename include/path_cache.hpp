@@ -0,0 +1,34 @@
+#ifndef PATH_CACHE_HPP
+#define PATH_CACHE_HPP
+
+#include "lemlib/asset.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// --- Path Cache ---
+// Parses LemLib path assets ("x, y, speed" lines up to "endData") ahead of time, while the robot is disabled, so
+// autonomous code can look up a path's points, length and end point without parsing text on the auton's first tick.
+
+struct PathPoint {
+    float x, y, speed;
+};
+
+struct PreparedPath {
+    const uint8_t* key = nullptr; // The asset's data; the ASSET() struct itself is per translation unit
+    std::vector<PathPoint> points;
+    size_t end = 0;               // Index of the end point (path exports add points past it for the lookahead)
+    float length = 0;             // Inches from the first point to the end point
+};
+
+#define PATH_CACHE_MAX 8
+
+// Parses a path asset. Returns false if it has no points.
+bool parsePath(const asset& path, std::vector<PathPoint>& points);
+// Parses and caches `path` if it isn't cached yet. Returns nullptr if it can't be parsed or the cache is full.
+// Call from one task at a time.
+const PreparedPath* preparePath(const asset& path);
+// Looks up a cached path without ever parsing; nullptr if it was not prepared. Safe from any task.
+const PreparedPath* findPreparedPath(const asset& path);
+
+#endif
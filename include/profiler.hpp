@@ -0,0 +1,61 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "main.h"
+#include "robot_config.hpp"
+#include <cstdint>
+
+// --- Profiler ---
+// Measures where the brain's CPU goes. Enabled with PROFILING_ENABLED in robot_config.hpp; when disabled every
+// macro below compiles to nothing.
+//
+// - PROFILE_SCOPE("name") times the rest of the enclosing block with pros::micros() and records the stack depth of
+//   the calling task at that point. Every scheduler job is profiled automatically.
+// - A probe task at the lowest priority measures how much time it does NOT get, which is the total load of every
+//   other task, including LemLib's odometry, motion and logger tasks that can't be instrumented directly.
+// - printProfile() reports per-scope CPU share and per-task stack high-water marks to the terminal and the log.
+
+struct ProfileSlot {
+    const char* name = nullptr;
+    uint32_t calls = 0;
+    uint32_t lastUs = 0;
+    uint32_t maxUs = 0;
+    uint64_t totalUs = 0;
+};
+
+// Returns the slot index for `name`, creating it on first use (-1 if the table is full)
+int profilerSlot(const char* name);
+// Adds one timed call to a slot
+void profilerRecord(int slot, uint32_t us);
+// Records the calling task's current stack depth (used for the high-water report)
+void profilerCheckpoint();
+// Starts the CPU load probe task
+void startProfiler();
+// Total CPU load of all tasks over the last probe window, in percent
+float profilerCpuLoad();
+// Prints the profile table and stack report
+void printProfile();
+
+class ProfileScope {
+    public:
+        explicit ProfileScope(int slot) : slot(slot), start(pros::micros()) { profilerCheckpoint(); }
+
+        ~ProfileScope() { profilerRecord(slot, pros::micros() - start); }
+    private:
+        int slot;
+        uint64_t start;
+};
+
+#if PROFILING_ENABLED
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name)                                                                                            \
+    static int PROFILE_CONCAT(profileSlot_, __LINE__) = profilerSlot(name);                                          \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profileSlot_, __LINE__))
+#define PROFILE_CHECKPOINT() profilerCheckpoint()
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_CHECKPOINT()
+#endif
+
+#endif
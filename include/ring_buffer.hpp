@@ -0,0 +1,69 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// --- SPSC Byte Ring ---
+// Fixed-size ring for exactly one producer task and one consumer task. Both sides are wait-free: push() either
+// copies the whole record or drops it (never a partial record), and neither side locks or allocates.
+template <size_t N> class SpscRing {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "ring size must be a power of two");
+    public:
+        // Producer side. Returns false and counts a drop if the record doesn't fit.
+        bool push(const void* data, size_t size) {
+            uint32_t head = this->head.load(std::memory_order_relaxed);
+            uint32_t tail = this->tail.load(std::memory_order_acquire);
+            if (size > N - (head - tail)) {
+                drops.fetch_add(1, std::memory_order_relaxed);
+                droppedBytes.fetch_add(size, std::memory_order_relaxed);
+                return false;
+            }
+            copyIn(head, static_cast<const uint8_t*>(data), size);
+            this->head.store(head + size, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side. Copies up to `max` bytes out and returns how many were copied.
+        size_t pop(void* out, size_t max) {
+            uint32_t tail = this->tail.load(std::memory_order_relaxed);
+            uint32_t head = this->head.load(std::memory_order_acquire);
+            size_t size = head - tail;
+            if (size > max) size = max;
+            copyOut(tail, static_cast<uint8_t*>(out), size);
+            this->tail.store(tail + size, std::memory_order_release);
+            return size;
+        }
+
+        size_t used() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+        uint32_t dropCount() const { return drops.load(std::memory_order_relaxed); }
+
+        uint32_t droppedByteCount() const { return droppedBytes.load(std::memory_order_relaxed); }
+
+        static constexpr size_t capacity() { return N; }
+    private:
+        void copyIn(uint32_t position, const uint8_t* data, size_t size) {
+            size_t start = position & (N - 1);
+            size_t first = (size < N - start) ? size : N - start;
+            std::memcpy(buffer + start, data, first);
+            std::memcpy(buffer, data + first, size - first);
+        }
+
+        void copyOut(uint32_t position, uint8_t* out, size_t size) {
+            size_t start = position & (N - 1);
+            size_t first = (size < N - start) ? size : N - start;
+            std::memcpy(out, buffer + start, first);
+            std::memcpy(out + first, buffer, size - first);
+        }
+
+        uint8_t buffer[N];
+        std::atomic<uint32_t> head = 0; // Total bytes written (wraps)
+        std::atomic<uint32_t> tail = 0; // Total bytes read (wraps)
+        std::atomic<uint32_t> drops = 0;
+        std::atomic<uint32_t> droppedBytes = 0;
+};
+
+#endif
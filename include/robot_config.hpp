@@ -75,6 +75,59 @@
 #define P_ANGULAR_KI 0.0           // Integral constant
 #define P_ANGULAR_KD 16.0          // Derivative constant
 
+// --- Startup ---
+// Slow bring-up steps run in parallel with the rest of initialize() (startup.hpp)
+#define IMU_CALIBRATION_TIMEOUT 3000  // ms before a calibration attempt is abandoned
+#define IMU_CALIBRATION_ATTEMPTS 2    // Attempts before odometry starts without a calibrated IMU
+#define STARTUP_WAIT_TIMEOUT 7000     // Longest autonomous() waits for startup to finish
+#define STARTUP_POLL_PERIOD 5         // ms between readiness checks while waiting
+#define MOTOR_HOT_TEMPERATURE 55      // Degrees C; motors this hot at startup are reported
+
+// --- Auton Selection ---
+#define AUTON_POT_RANGE 330            // Selector pot readings from 0 to this are split between the autons
+#define AUTON_SELECT_STABLE_TIME 600   // ms the selection must hold before the auton is prepared
+#define AUTON_PATH_START_TOLERANCE 6   // Inches between the start pose and first path point before warning
+
+// --- Start Detection ---
+// At the start of autonomous the distance sensors are matched against every auton's start pose (start_tile.hpp)
+#define START_DETECT_ENABLED 1
+#define FIELD_HALF_WIDTH 70.2             // Inches from the field center to the inside of the perimeter
+#define START_DETECT_MIN_SENSORS 3        // Sensors that must agree with a start pose
+#define START_DETECT_BASE_TOLERANCE 1.0   // Inches a reading may be off...
+#define START_DETECT_RANGE_TOLERANCE 0.05 // ...plus this fraction of the distance (the sensor's rated accuracy)
+#define START_DETECT_MIN_CONFIDENCE 20    // Readings below this confidence (0-63) are ignored
+
+// --- Path Following ---
+#define FOLLOW_LOOKAHEAD 3       // Pure pursuit lookahead distance (inches)
+
+// --- Driver Control ---
+// Exponential drive curve of the default driver profile (other profiles are in drive_curves.cpp)
+#define DRIVE_CURVE_DEADBAND 3     // Joystick values below this are ignored
+#define DRIVE_CURVE_MIN_OUTPUT 20  // Smallest output once past the deadband
+#define DRIVE_CURVE_GAIN 1.02      // Expo gain (1 is linear)
+#define DRIVER_PROFILE_NEXT_BUTTON pros::E_CONTROLLER_DIGITAL_RIGHT // Switches to the next driver profile
+#define DRIVER_PROFILE_PREV_BUTTON pros::E_CONTROLLER_DIGITAL_LEFT  // Switches to the previous driver profile
+
+// --- Driver Macros ---
+// Driver control recorded with its pose trace and replayed with drift correction (macro.hpp)
+#define MACRO_MAX_FRAMES 12000       // 2 minutes at the drive loop rate (~120 KB of RAM)
+#define MACRO_PATH "/usd/macro.bin"  // Where the recording is saved when disabled
+#define MACRO_RECORD_BUTTON pros::E_CONTROLLER_DIGITAL_X // Starts/stops recording
+#define MACRO_PLAY_BUTTON pros::E_CONTROLLER_DIGITAL_B   // Plays the recording from its start pose
+#define MACRO_ABORT_STICK 30         // Stick movement beyond this stops playback
+
+// --- Heading Hold ---
+// Keeps the robot straight while driving with no turn input (heading_hold.hpp)
+#define HEADING_HOLD_DEFAULT 0       // 1 to start driver control with the assist on
+#define HEADING_HOLD_BUTTON pros::E_CONTROLLER_DIGITAL_Y // Toggles the assist
+#define HOLD_KP 2.0                  // Proportional constant (turn units per degree)
+#define HOLD_KI 0.0                  // Integral constant
+#define HOLD_KD 8.0                  // Derivative constant
+#define HOLD_TURN_DEADBAND 5         // Turn stick beyond this releases the hold
+#define HOLD_THROTTLE_DEADBAND 5     // Throttle needed before the hold engages
+#define HOLD_LATCH_RATE 20           // deg/s; the heading is latched once rotation is slower than this
+#define HOLD_MAX_TURN 40             // Largest correction (out of 127)
+
 // --- Distance Sensor Offsets ---
 // Distance from the actual distance sensor reading point to the closest physical edge of the robot
 // in that direction. E.g., if your front sensor is 1 inch behind the absolute front of the robot.
@@ -83,4 +136,60 @@
 #define DS_LEFT_CENTER  1.75
 #define DS_RIGHT_CENTER 1.75
 
+// --- Input Logging ---
+// Every device snapshot is recorded during auton and driver control and saved to the SD card when disabled.
+#define INPUT_LOG_ENABLED 1         // Set to 0 to turn input recording off
+#define INPUT_LOG_MAX_RECORDS 18000 // 3 minutes at the device update rate (~1.1 MB of RAM)
+#define INPUT_LOG_MAX_FILES 1000    // inputs_000.bin to inputs_999.bin; later runs aren't saved
+
+// --- Flight Recorder ---
+// Pose, motor and PID records written to the SD card in 4 KB blocks during every match phase (flight_recording.hpp).
+#define FLIGHT_RECORDER_ENABLED 1   // Set to 0 to turn flight recording off
+#define FLIGHT_DIRECTORY "/usd"     // Where run_NNNN.kfr and runs.idx are written
+#define FLIGHT_RECORD_PERIOD 10     // ms between samples
+#define FLIGHT_FLUSH_PERIOD 50      // ms between checks for full blocks to write
+
+// --- Profiling ---
+#define PROFILING_ENABLED 1         // Set to 0 to compile all profiling out
+#define PROFILE_REPORT_PERIOD 10000 // ms between profile reports to the terminal and log
+
+// --- Serial Output ---
+// Log text and telemetry frames are queued in per-task rings and written to stdout by one drain task.
+#define SERIAL_RING_SIZE 4096    // Bytes per producing task (power of two)
+#define SERIAL_MAX_PRODUCERS 6   // Tasks that can write; extra writers are dropped and counted
+#define SERIAL_DRAIN_PERIOD 5    // ms between drains
+
+// --- Deferred Logging ---
+// Lowest level that is compiled in: 0 INFO, 1 DEBUG, 2 WARN, 3 ERROR, 4 FATAL (same order as lemlib::Level)
+#define LOG_COMPILE_LEVEL 0
+#define LOG_RING_SIZE 2048     // Bytes of captured records per producing task (power of two, 64 bytes per record)
+#define LOG_MAX_PRODUCERS 6    // Tasks that can log; extra writers are dropped and counted
+#define LOG_FORMAT_PERIOD 20   // ms between formatting passes
+
+// --- Telemetry ---
+// Binary pose/drive/PID records streamed over the serial line (decode with tools/telemetry_decode).
+// Enabling it switches the terminal to raw mode, so printf text and frames share the line.
+#define TELEMETRY_ENABLED 0
+#define TELEMETRY_PERIOD 10 // ms between records
+
+// --- Watchdog ---
+#define WATCHDOG_PERIOD 20             // ms between watchdog checks
+#define WATCHDOG_OVERRUN_FACTOR 1.5    // A cycle longer than this many periods is an overrun
+#define WATCHDOG_STALL_CYCLES 5        // A loop silent for this many periods is stalled
+#define WATCHDOG_MAX_DEGRADATION 3     // Background jobs slow down by up to 2^3 = 8x
+#define WATCHDOG_ESCALATE_TIME 100     // ms between degradation increases
+#define WATCHDOG_RECOVERY_TIME 2000    // ms without overruns before a level is restored
+
+// --- Task Periods (ms) ---
+// Periodic jobs are registered with the scheduler (scheduler.hpp); faster jobs get higher priorities.
+#define DEVICE_UPDATE_PERIOD 10       // Device snapshot refresh (matches the V5 smart-port update rate)
+#define ODOM_PUBLISH_PERIOD 10        // Odometry snapshot publication (matches the LemLib odometry tick)
+#define MOTION_MONITOR_PERIOD 5       // Motion handle completion checks (bounds wake-up latency)
+#define DRIVE_LOOP_PERIOD DEVICE_UPDATE_PERIOD // opcontrol() driving loop (one command per motor update)
+#define POSE_DISPLAY_PERIOD 25        // Brain screen pose readout
+#define CONTROLLER_INFO_PERIOD 1000   // Controller battery/temperature readout (only changed lines are sent)
+#define CONTROLLER_DISPLAY_PERIOD 50  // Controller screen sends (about the fastest the controller accepts)
+#define SCHEDULER_REPORT_PERIOD 10000 // Job timing table printed to the terminal (0 disables)
+#define DRIVER_REPORT_PERIOD 10000    // Driver stick-to-command latency logged to the terminal
+
 #endif
\ No newline at end of file
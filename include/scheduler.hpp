@@ -0,0 +1,72 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "main.h"
+#include "snapshot.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// --- Periodic Jobs ---
+// Subsystems register work here instead of spinning up their own pros::Task lambdas.
+// Each job runs in its own task, released every `period` ms with pros::Task::delay_until.
+
+// Timing statistics for one job. Execution times are measured with pros::micros().
+struct JobStats {
+    uint32_t runs = 0;           // Number of completed releases
+    uint32_t deadlineMisses = 0; // Releases that finished later than `deadline` ms after they were due
+    uint32_t skippedReleases = 0; // Releases dropped because the job fell more than a full period behind
+    uint32_t lastExecUs = 0;     // Execution time of the most recent run
+    uint32_t maxExecUs = 0;      // Worst execution time seen
+    uint64_t totalExecUs = 0;    // Sum of all execution times (for average and CPU utilisation)
+};
+
+struct PeriodicJob {
+    const char* name;
+    uint32_t period;   // Milliseconds between releases
+    uint32_t deadline; // Milliseconds after release the job must finish by
+    uint32_t priority; // PROS task priority the job runs at
+    bool autoPriority; // True if the priority was assigned rate-monotonically
+    bool critical;     // Control work: never slowed down and watched by the watchdog
+    std::function<void()> fn;
+    Snapshot<JobStats> stats; // Published by the job's own task
+    pros::task_t task = nullptr;
+    int watchdogLoop = -1;
+};
+
+class Scheduler {
+    public:
+        // Registers a job. A priority of 0 means rate-monotonic: shorter periods get higher priorities.
+        // A deadline of 0 means the job must finish before its next release.
+        PeriodicJob& addJob(const char* name, uint32_t period, std::function<void()> fn, uint32_t priority = 0,
+                            uint32_t deadline = 0);
+        // Registers a non-critical job (UI, telemetry, reports). Its period is stretched while degraded.
+        PeriodicJob& addBackgroundJob(const char* name, uint32_t period, std::function<void()> fn);
+        // Background jobs run every period << level ms; set by the watchdog when control loops overrun
+        void setDegradation(int level) { degradation = level; }
+
+        int getDegradation() const { return degradation; }
+
+        // Creates the tasks for every registered job. Jobs added afterwards start immediately.
+        void start();
+        // Copy of a job's statistics (all zero if no job has that name)
+        JobStats getStats(const char* name) const;
+        // Prints a per-job timing table to the terminal
+        void printStats() const;
+    private:
+        PeriodicJob& add(const char* name, uint32_t period, std::function<void()> fn, uint32_t priority,
+                         uint32_t deadline, bool critical);
+        void assignPriorities();
+        void startJob(PeriodicJob& job);
+        void runJob(PeriodicJob* job);
+
+        std::vector<std::unique_ptr<PeriodicJob>> jobs;
+        bool started = false;
+        std::atomic<int> degradation = 0;
+};
+
+extern Scheduler scheduler;
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef SERIAL_OUT_HPP
+#define SERIAL_OUT_HPP
+
+#include "main.h"
+#include "ring_buffer.hpp"
+#include "robot_config.hpp"
+#include "lemlib/logger/baseSink.hpp"
+#include <atomic>
+#include <memory>
+
+// --- Serial Output ---
+// Non-blocking replacement for lemlib::bufferedStdout. Every producing task gets its own SpscRing (claimed on its
+// first write), and one low-priority drain task copies whole rings to stdout. Writing from a control loop is a
+// memcpy into preallocated memory; if a ring is full the record is dropped and counted instead of blocking.
+// The drain task takes back the ring of a task that has been deleted (competition tasks are recreated on every mode
+// switch), so only SERIAL_MAX_PRODUCERS tasks have to be writing at the same time.
+
+class SerialOut {
+    public:
+        // Starts the drain task
+        void start();
+
+        // Queues raw bytes (one telemetry frame, one line of text...). Returns false if the record was dropped.
+        bool write(const void* data, size_t size);
+
+        // Formats into a stack buffer (no heap) and queues the text; output longer than 255 characters is cut off
+        template <typename... T> bool print(fmt::format_string<T...> format, T&&... args) {
+            char text[256];
+            auto result = fmt::format_to_n(text, sizeof(text), format, std::forward<T>(args)...);
+            return write(text, result.size < sizeof(text) ? result.size : sizeof(text));
+        }
+
+        // Records dropped across every ring
+        uint32_t dropCount() const;
+    private:
+        struct Producer {
+                std::atomic<pros::task_t> task = nullptr;
+                SpscRing<SERIAL_RING_SIZE> ring;
+        };
+
+        void drainLoop();
+
+        Producer producers[SERIAL_MAX_PRODUCERS];
+        std::atomic<uint32_t> unclaimedDrops = 0; // Writes from tasks beyond SERIAL_MAX_PRODUCERS
+};
+
+extern SerialOut serialOut;
+
+// True once a ring's owner task has been deleted, so the ring can go to another task
+bool producerGone(pros::task_t task);
+
+// LemLib sink that sends its messages through serialOut instead of lemlib::bufferedStdout
+class RingSink : public lemlib::BaseSink {
+    public:
+        RingSink();
+    protected:
+        void sendMessage(const lemlib::Message& message) override;
+};
+
+// Shared instance for our own log messages
+std::shared_ptr<RingSink> ringSink();
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// --- Snapshot ---
+// Single-writer, many-reader publication of a small struct without locks.
+// The writer always fills the slot readers are NOT pointed at and then flips `active`, so a reader never waits on a
+// writer that got preempted half way through (which a plain seqlock would do on the single-core V5 brain).
+// Each slot also carries a sequence number; a reader only retries if the writer lapped it twice mid-copy.
+template <typename T> class Snapshot {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshot<T> copies T word by word");
+        static_assert(std::is_default_constructible_v<T>, "Snapshot<T> needs a default value to return");
+    public:
+        // Writer side. Only one task may publish to a given snapshot.
+        void publish(const T& value) {
+            uint32_t next = active.load(std::memory_order_relaxed) ^ 1;
+            Slot& slot = slots[next];
+            slot.seq.fetch_add(1, std::memory_order_relaxed); // odd: slot is being written
+            std::atomic_thread_fence(std::memory_order_release);
+            uint32_t words[WORDS] = {};
+            std::memcpy(words, &value, sizeof(T));
+            for (unsigned i = 0; i < WORDS; i++) slot.words[i].store(words[i], std::memory_order_relaxed);
+            slot.seq.fetch_add(1, std::memory_order_release); // even: slot is stable again
+            active.store(next, std::memory_order_release);
+            hasValue.store(true, std::memory_order_release);
+        }
+
+        // Reader side. Safe from any number of tasks; returns a default T until the first publish.
+        T load() const {
+            T out {};
+            load(out);
+            return out;
+        }
+
+        // Returns false (and leaves `out` untouched) until something has been published
+        bool load(T& out) const {
+            if (!hasValue.load(std::memory_order_acquire)) return false;
+            uint32_t words[WORDS];
+            while (true) {
+                const Slot& slot = slots[active.load(std::memory_order_acquire)];
+                uint32_t before = slot.seq.load(std::memory_order_acquire);
+                if (before & 1) continue; // writer lapped us and is refilling this slot; re-read `active`
+                for (unsigned i = 0; i < WORDS; i++) words[i] = slot.words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) == before) break;
+            }
+            std::memcpy(&out, words, sizeof(T));
+            return true;
+        }
+    private:
+        static constexpr unsigned WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+        struct Slot {
+                std::atomic<uint32_t> seq {0};
+                std::atomic<uint32_t> words[WORDS] {};
+        };
+
+        Slot slots[2];
+        std::atomic<uint32_t> active {0};
+        std::atomic<bool> hasValue {false};
+};
+
+#endif
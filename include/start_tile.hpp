@@ -0,0 +1,49 @@
+#ifndef START_TILE_HPP
+#define START_TILE_HPP
+
+#include <cstddef>
+
+// --- Start Tile Detection ---
+// Matches one reading of the four distance sensors against a candidate start pose: each sensor's expected distance
+// to the perimeter wall is ray-cast from the pose, and the sensors that agree also pin down the robot's exact
+// position along the axis of the wall they see. Standard library only, so detection can be checked in a host
+// simulation.
+// Poses use LemLib's convention: inches, heading in degrees clockwise from +Y.
+
+struct StartPose {
+    float x, y, theta; // Inches, inches, degrees
+};
+
+enum StartSensor { START_SENSOR_RIGHT, START_SENSOR_LEFT, START_SENSOR_FRONT, START_SENSOR_BACK, START_SENSOR_COUNT };
+
+struct StartSensorMount {
+    float angle;  // Degrees clockwise from the robot's front
+    float offset; // Inches from the tracking center to the sensor face, along `angle`
+};
+
+struct StartFitSettings {
+    StartSensorMount mounts[START_SENSOR_COUNT];
+    float fieldHalfWidth;     // Inches from the field center to the inside of each wall
+    float baseTolerance;      // Inches a reading may differ from the expected distance...
+    float rangeTolerance;     // ...plus this fraction of the expected distance
+    int minSensors;           // Agreeing sensors needed for a match
+};
+
+struct StartFit {
+    bool matched = false;
+    int agreeing = 0;     // Sensors within tolerance
+    float score = 0;      // Sum of squared (error / tolerance) over the agreeing sensors; lower is better
+    StartPose pose {};    // Candidate pose corrected along the axes the agreeing sensors measured
+};
+
+// Distance from (x, y) along `heading` to the first wall; sets `hitsSide` when that wall is x = +/-halfWidth
+float wallDistance(float x, float y, float heading, float halfWidth, bool* hitsSide = nullptr);
+
+// Fits `readings` (inches from each sensor face, negative when a sensor has no valid reading) to `candidate`
+StartFit fitStartPose(const StartPose& candidate, const float (&readings)[START_SENSOR_COUNT],
+                      const StartFitSettings& settings);
+
+// Alliance start poses are written for red; blue starts are the same poses turned 180 degrees about the field center
+StartPose allianceStartPose(const StartPose& red, bool isRed);
+
+#endif
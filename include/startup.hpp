@@ -0,0 +1,35 @@
+#ifndef STARTUP_HPP
+#define STARTUP_HPP
+
+#include "main.h"
+#include "robot_config.hpp"
+
+// --- Startup ---
+// Brings the robot up in parallel instead of blocking initialize() behind the IMU. startStartup() runs each step on
+// its own short-lived task and returns at once:
+//   IMU      calibration started without blocking; odometry (chassis.calibrate(false)) starts once it finishes
+//   DEVICES  tracking wheel resets, presence/type check of every smart port, motor temperature check, next input
+//            log number on the SD card
+//   PATHS    every auton's path assets parsed into the path cache, and the saved driver macro loaded
+//   UI       brain LCD and the first controller lines
+// Each step marks itself ready when it is done (or has given up). Driving needs none of them, so opcontrol() only
+// gates the features that need a heading; autonomous() waits for whatever is still running.
+
+enum StartupStep : uint32_t {
+    STARTUP_IMU = 1 << 0,
+    STARTUP_DEVICES = 1 << 1,
+    STARTUP_PATHS = 1 << 2,
+    STARTUP_UI = 1 << 3,
+    STARTUP_ALL = STARTUP_IMU | STARTUP_DEVICES | STARTUP_PATHS | STARTUP_UI,
+};
+
+// Starts every step. Call once, first thing in initialize().
+void startStartup();
+// True once all of `steps` are done
+bool startupReady(uint32_t steps);
+// Steps that finished with a problem (missing device, IMU that never calibrated); they still count as ready
+uint32_t startupFailures();
+// Waits until all of `steps` are done or `timeout` ms pass. Returns immediately when they are already done.
+bool waitForStartup(uint32_t steps, uint32_t timeout = STARTUP_WAIT_TIMEOUT);
+
+#endif
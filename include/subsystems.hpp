@@ -6,4 +6,9 @@
 
 //Prototypes for subsytems goes here
 
-#endif
\ No newline at end of file
+// Runs every subsystem's driver controls from controller buttons, so recorded macros can drive them the same way.
+// `held` and `pressed` use the ControllerState::buttons bit layout; `pressed` only has buttons that went down since
+// the last call.
+void subsystemControl(uint16_t held, uint16_t pressed);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include "main.h"
+#include "telemetry_format.hpp"
+#include <atomic>
+#include <type_traits>
+
+// --- Binary Telemetry ---
+// Sends fixed-layout records over the serial line as COBS frames (see telemetry_format.hpp) instead of formatting
+// text through lemlib::BaseSink. A record is a few dozen bytes of encoding plus a push into serialOut's ring, with
+// no heap allocations or locks.
+// Decode on the host with tools/telemetry_decode.
+
+class BinaryTelemetry {
+    public:
+        // Switches the serial line to raw mode so frames reach the host unwrapped.
+        // Use `pros terminal --raw` (or the decoder) to read the output afterwards.
+        void begin();
+
+        // Sends one record on `channel`. The payload type must match the channel's layout.
+        template <typename T> void send(TelemetryChannel channel, const T& payload) {
+            static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= TELEMETRY_MAX_PAYLOAD);
+            sendRaw(channel, &payload, sizeof(T));
+        }
+
+        uint32_t framesSent() const { return frames; }
+
+        uint32_t bytesSent() const { return bytes; }
+    private:
+        void sendRaw(uint8_t channel, const void* payload, size_t size);
+
+        std::atomic<uint32_t> frames = 0;
+        std::atomic<uint32_t> bytes = 0;
+};
+
+extern BinaryTelemetry telemetry;
+
+// Captures the state of one of LemLib's PID controllers
+PidSample samplePid(PidLoop loop, const lemlib::PID& pid);
+
+// Sends pose, drive and PID records for the current tick. Registered as a background scheduler job.
+void telemetryUpdate();
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef TELEMETRY_FORMAT_HPP
+#define TELEMETRY_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// --- Binary Telemetry Format ---
+// Shared by the robot (telemetry.hpp) and the host decoder (tools/telemetry_decode.cpp); standard library only.
+//
+// A record is [channel:u8][time:u32][payload][crc8:u8], little-endian, where the payload is the fixed-layout
+// struct for that channel. Each record is COBS-encoded and wrapped in 0x00 delimiters on both sides, so a reader can
+// resync after dropped bytes and tell frames apart from ordinary printf text on the same serial line.
+
+enum TelemetryChannel : uint8_t {
+    TELEMETRY_POSE = 1,
+    TELEMETRY_DRIVE = 2,
+    TELEMETRY_PID = 3,
+};
+
+struct PoseSample {
+    float x, y, theta;             // Inches, inches, degrees
+    float xVel, yVel, thetaVel;    // Per second
+};
+
+struct DriveSample {
+    float leftVelocity, rightVelocity; // Average motor RPM per side
+    int32_t leftVoltage, rightVoltage; // Average mV per side
+    int32_t leftCurrent, rightCurrent; // Total mA per side
+};
+
+// Which controller a PidSample belongs to
+enum PidLoop : uint32_t { PID_LATERAL = 0, PID_ANGULAR = 1, PID_HEADING_HOLD = 2 };
+
+struct PidSample {
+    uint32_t loop;      // PidLoop
+    float error;
+    float integral;
+    float p, i, d;      // Individual terms (NaN when the controller doesn't expose them)
+    float output;       // NaN when unknown
+};
+
+// Field layout of each channel, for decoders: one type letter per field ('f' float, 'i' int32, 'u' uint32)
+struct TelemetryChannelInfo {
+    uint8_t id;
+    const char* name;
+    size_t size;
+    const char* types;
+    const char* fields; // Comma separated, CSV header order
+};
+
+inline constexpr TelemetryChannelInfo TELEMETRY_CHANNELS[] = {
+    {TELEMETRY_POSE, "pose", sizeof(PoseSample), "ffffff", "x,y,theta,x_vel,y_vel,theta_vel"},
+    {TELEMETRY_DRIVE, "drive", sizeof(DriveSample), "ffiiii",
+     "left_rpm,right_rpm,left_mv,right_mv,left_ma,right_ma"},
+    {TELEMETRY_PID, "pid", sizeof(PidSample), "uffffff", "loop,error,integral,p,i,d,output"},
+};
+
+// Header (channel + time) and trailing CRC around the payload
+#define TELEMETRY_OVERHEAD 6
+#define TELEMETRY_MAX_PAYLOAD 64
+// Worst-case encoded frame: COBS adds one code byte (payloads stay under 254 bytes) plus the two delimiters
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_PAYLOAD + TELEMETRY_OVERHEAD + 3)
+
+// Looks up a channel's layout, or nullptr if unknown
+const TelemetryChannelInfo* telemetryChannelInfo(uint8_t id);
+
+// CRC-8 (polynomial 0x07)
+uint8_t crc8(const uint8_t* data, size_t length);
+
+// COBS-encodes `length` bytes into `out` (at least length + length / 254 + 1 bytes). Returns the encoded length,
+// not including the 0x00 delimiter.
+size_t cobsEncode(const uint8_t* data, size_t length, uint8_t* out);
+
+// Decodes one frame (without its delimiter) into `out`. Returns the decoded length, or 0 if the frame is malformed.
+size_t cobsDecode(const uint8_t* data, size_t length, uint8_t* out);
+
+// Builds a complete delimited frame for one record. Returns the number of bytes written to `out`.
+size_t telemetryEncode(uint8_t channel, uint32_t time, const void* payload, size_t size,
+                       uint8_t out[TELEMETRY_MAX_FRAME]);
+
+#endif
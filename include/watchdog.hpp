@@ -0,0 +1,37 @@
+#ifndef WATCHDOG_HPP
+#define WATCHDOG_HPP
+
+#include "main.h"
+#include <cstdint>
+
+// --- Control-Loop Watchdog ---
+// Critical loops call watchdogBeat() once per cycle. A cycle longer than WATCHDOG_OVERRUN_FACTOR periods is
+// recorded as an overrun together with its cycle time, and a loop that stops beating is recorded as a stall.
+// While overruns keep happening, the watchdog raises the scheduler's degradation level so UI and telemetry jobs
+// run less often; once the loops have been clean for WATCHDOG_RECOVERY_TIME it steps back down.
+// Every critical scheduler job is registered automatically.
+// LemLib's own motion and odometry tasks are not watched: they are created inside the precompiled library, which
+// offers no hook to beat from. A stall there shows up only indirectly, through the jobs and loops that wait on it.
+
+struct LoopHealth {
+    const char* name = nullptr;
+    uint32_t period = 0;        // Expected cycle time, ms
+    uint32_t lastBeatUs = 0;    // pros::micros() of the latest beat, wrapping (0 while disarmed)
+    uint32_t lastCycleUs = 0;   // Time between the latest two beats
+    uint32_t worstCycleUs = 0;
+    uint32_t overruns = 0;
+    uint32_t stalls = 0;
+};
+
+// Registers a critical loop and returns its id (-1 if the table is full)
+int watchdogRegister(const char* name, uint32_t period);
+// Marks one cycle of a loop
+void watchdogBeat(int loop);
+// Stops stall detection for a loop that is deliberately not running (re-armed by the next beat)
+void watchdogDisarm(int loop);
+// Checks for stalls, prints new overruns and adjusts the degradation level. Registered as a scheduler job.
+void watchdogUpdate();
+// Copy of a loop's health counters
+LoopHealth watchdogHealth(int loop);
+
+#endif
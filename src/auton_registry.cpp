@@ -0,0 +1,147 @@
+#include "auton_registry.hpp"
+#include "robot_config.hpp"
+#include "path_cache.hpp"
+#include "deferred_log.hpp"
+#include "device_state.hpp"
+#include "controller_display.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+static std::atomic<int> prepared = 0; // Selection that has been prepared (0 for none)
+static int pending = 0;               // Selection being watched for stability
+static uint32_t pendingSince = 0;
+
+const AutonDescriptor& autonDescriptor(int selection) {
+    return (selection >= 1 && selection <= AUTON_COUNT) ? AUTONS[selection - 1] : AUTONS[0];
+}
+
+const char* autonSideName(AutonSide side) {
+    switch (side) {
+        case AutonSide::LEFT: return "Left";
+        case AutonSide::RIGHT: return "Right";
+        case AutonSide::SKILLS: return "Skills";
+        default: return "";
+    }
+}
+
+int autonFromPot(int potValue) {
+    // The pot reads 0 to AUTON_POT_RANGE
+    int selection = potValue * AUTON_COUNT / (AUTON_POT_RANGE + 1) + 1;
+    return std::clamp(selection, 1, AUTON_COUNT);
+}
+
+static void prepare(int selection) {
+    const AutonDescriptor& auton = autonDescriptor(selection);
+    for (int i = 0; i < AUTON_MAX_PATHS && auton.paths[i] != nullptr; i++) {
+        const PreparedPath* path = preparePath(*auton.paths[i]);
+        if (path == nullptr) {
+            LOG_WARN("auton {}: path {} could not be parsed", auton.name, i);
+            continue;
+        }
+        // The first path should begin where the robot is placed
+        float offset = std::hypot(path->points[0].x - auton.start.x, path->points[0].y - auton.start.y);
+        if (i == 0 && offset > AUTON_PATH_START_TOLERANCE) {
+            LOG_WARN("auton {}: first path starts {:.1f} in from the start pose", auton.name, offset);
+        }
+    }
+    if (auton.prepare != nullptr) auton.prepare();
+    prepared = selection;
+    LOG_INFO("auton {} prepared", auton.name);
+}
+
+bool autonPrepared(int selection) { return prepared == selection; }
+
+void updateAutonSelection(int selection) {
+    uint32_t now = pros::millis();
+    if (selection != pending) {
+        pending = selection;
+        pendingSince = now;
+        return;
+    }
+    if (prepared != selection && now - pendingSince >= AUTON_SELECT_STABLE_TIME) prepare(selection);
+}
+
+static const StartFitSettings START_FIT = {
+    .mounts = {{90, DS_RIGHT_CENTER}, {-90, DS_LEFT_CENTER}, {0, DS_FRONT_CENTER}, {180, DS_BACK_CENTER}},
+    .fieldHalfWidth = FIELD_HALF_WIDTH,
+    .baseTolerance = START_DETECT_BASE_TOLERANCE,
+    .rangeTolerance = START_DETECT_RANGE_TOLERANCE,
+    .minSensors = START_DETECT_MIN_SENSORS,
+};
+
+// Inches from the sensor face, or -1 when the sensor sees nothing it is sure of
+static float startReading(const DistanceState& sensor) {
+    if (sensor.distance <= 0 || sensor.distance >= 9999 || sensor.confidence < START_DETECT_MIN_CONFIDENCE) return -1;
+    return sensor.distance / 25.4f;
+}
+
+// Autons left at the origin are written relative to wherever the robot is placed, so they have no tile to match
+static bool relativeStart(const StartPose& pose) { return pose.x == 0 && pose.y == 0; }
+
+// True when `a` fits the sensors better than `b`
+static bool betterFit(const StartFit& a, const StartFit& b) {
+    return a.agreeing != b.agreeing ? a.agreeing > b.agreeing : a.score < b.score;
+}
+
+StartDetection detectStart(int selection, bool red) {
+    uint32_t start = pros::micros();
+    const AutonDescriptor& selected = autonDescriptor(selection);
+    StartDetection result {selection, selected.start, false, false};
+    // A relative auton runs wherever it is placed: there is nothing to check, and nothing to warn the driver about
+    if (!START_DETECT_ENABLED || relativeStart(selected.start)) return result;
+
+    // One snapshot, so all four readings are from the same device update
+    DeviceState state = deviceState.load();
+    const float readings[START_SENSOR_COUNT] = {startReading(state.rightDist), startReading(state.leftDist),
+                                                startReading(state.frontDist), startReading(state.backDist)};
+
+    // The pot's choice wins whenever the sensors agree with it
+    StartFit best = fitStartPose(allianceStartPose(selected.start, red), readings, START_FIT);
+    int bestSelection = best.matched ? selection : 0;
+    bool ambiguous = false;
+    for (int i = 1; i <= AUTON_COUNT && bestSelection != selection; i++) {
+        const StartPose& pose = autonDescriptor(i).start;
+        if (relativeStart(pose)) continue;
+        StartFit fit = fitStartPose(allianceStartPose(pose, red), readings, START_FIT);
+        if (!fit.matched) continue;
+        if (bestSelection == 0 || betterFit(fit, best)) {
+            best = fit;
+            bestSelection = i;
+            ambiguous = false;
+        } else if (!betterFit(best, fit)) {
+            ambiguous = true; // Same tile as another auton; the sensors can't tell them apart
+        }
+    }
+    if (bestSelection != 0 && !ambiguous) {
+        result.selection = bestSelection;
+        result.overridden = bestSelection != selection;
+        result.matched = true;
+        // Measured position, brought back into the auton's own coordinates; the heading is the one it was placed at
+        StartPose measured = allianceStartPose(best.pose, red);
+        result.pose = {measured.x, measured.y, autonDescriptor(bestSelection).start.theta};
+    }
+    uint32_t elapsed = pros::micros() - start;
+
+    const AutonDescriptor& auton = autonDescriptor(result.selection);
+    if (!result.matched) {
+        LOG_WARN("start detect: no start pose matched (ambiguous: {}), keeping {}", ambiguous, selected.name);
+        controllerDisplay.print(2, "No start match");
+    } else if (result.overridden) {
+        LOG_WARN("start detect: robot is at the {} start, not {}", auton.name, selected.name);
+        controllerDisplay.print(2, "Auto: {}", auton.name);
+    } else {
+        LOG_INFO("start detect: {} confirmed by {} sensors", auton.name, best.agreeing);
+        controllerDisplay.print(2, "{} OK", auton.name);
+    }
+    LOG_INFO("start detect: pose ({:.1f}, {:.1f}, {:.0f}) in {} us", result.pose.x, result.pose.y, result.pose.theta,
+             elapsed);
+    return result;
+}
+
+void runAuton(int selection, const StartPose& start) {
+    const AutonDescriptor& auton = autonDescriptor(selection);
+    if (!autonPrepared(selection)) prepare(selection); // No competition_initialize() (e.g. run from the brain menu)
+    chassis.setPose(start.x, start.y, start.theta);
+    auton.run();
+}
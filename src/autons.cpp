@@ -1,16 +1,20 @@
 #include "main.h"
 #include "lemlib/api.hpp"
 #include "autons.hpp"
+#include "auton_registry.hpp"
+#include "params.hpp"
 #include "robot_config.hpp"
 #include <cmath>
 
 ASSET(path_jerryio_txt);
 
+CoScheduler autonRuntime(pros::millis, pros::Task::delay_until);
+float followLookahead = FOLLOW_LOOKAHEAD;
+
 void auton1() {
-    chassis.setPose(0, 0, 0);
     moveLinear(12);
     chassisPID("precise");
-    chassis.follow(path_jerryio_txt, 3, 20000);
+    motion::follow(path_jerryio_txt, followLookahead, 20000);
 }
 void auton2() {
     
@@ -40,52 +44,64 @@ void auton10() {
     
 }
 
+// --- Auton Registry ---
+// Selector pot order. Start poses are red-alliance field coordinates (checked against the distance sensors by
+// detectStart()) and are applied by runAuton() right before the routine runs; leave them at the origin for relative
+// autons.
+constexpr AutonDescriptor AUTONS[] = {
+    {"Auton1", AutonSide::ANY, {0, 0, 0}, {&path_jerryio_txt}, nullptr, auton1},
+    {"Auton2", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton2},
+    {"Auton3", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton3},
+    {"Auton4", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton4},
+    {"Auton5", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton5},
+    {"Auton6", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton6},
+    {"Auton7", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton7},
+    {"Auton8", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton8},
+    {"Auton9", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton9},
+    {"Auton10", AutonSide::ANY, {0, 0, 0}, {}, nullptr, auton10},
+};
+constexpr int AUTON_COUNT = sizeof(AUTONS) / sizeof(AUTONS[0]);
+
 
 
-void moveLinear(double inches, int timeout, float maxspeed, float minspeed) {
+MotionHandle moveLinear(double inches, int timeout, float maxspeed, float minspeed) {
         lemlib::Pose currentPose = chassis.getPose();
         double currentThetaRad = lemlib::degToRad(currentPose.theta);
         double targetX = currentPose.x + (inches * std::cos(currentThetaRad));
         double targetY = currentPose.y + (inches * std::sin(currentThetaRad));
-        chassis.moveToPose(targetX, targetY, currentPose.theta, timeout, {.lead = 0.2, .maxSpeed = maxspeed, .minSpeed = minspeed});
+        return motion::moveToPose(targetX, targetY, currentPose.theta, timeout, {.lead = 0.2, .maxSpeed = maxspeed, .minSpeed = minspeed});
     }
 
+// Gains go through the parameter registry, so values tuned over serial (params.hpp) survive a preset
+static void presetGains(double lat_kp, double lat_ki, double lat_kd, double ang_kp, double ang_ki, double ang_kd) {
+    params.preset("lat.kp", lat_kp);
+    params.preset("lat.ki", lat_ki);
+    params.preset("lat.kd", lat_kd);
+    params.preset("ang.kp", ang_kp);
+    params.preset("ang.ki", ang_ki);
+    params.preset("ang.kd", ang_kd);
+}
+
 void chassisPID(std::string premade, double lat_kp, double lat_ki, double lat_kd, double lat_slew, double ang_kp, double ang_ki, double ang_kd){
     // normal, fast, precise
     int selector = 0;
     if (premade=="normal"){selector=1;}else if(premade=="fast"){selector=2;}else if(premade=="precise"){selector=3;}
     switch (selector) {
     case 0:
-        chassis.lateralPID.kP = lat_kp;
-        chassis.lateralPID.kI = lat_ki;
-        chassis.lateralPID.kD = lat_kd;
-        chassis.angularPID.kP = ang_kp;
-        chassis.angularPID.kI = ang_ki;
-        chassis.angularPID.kD = ang_kd;
+        presetGains(lat_kp, lat_ki, lat_kd, ang_kp, ang_ki, ang_kd);
+        break;
     case 1:
         //normal
-        chassis.lateralPID.kP = LATERAL_KP;
-        chassis.lateralPID.kI = LATERAL_KI;
-        chassis.lateralPID.kD = LATERAL_KD;
-        chassis.angularPID.kP = ANGULAR_KP;
-        chassis.angularPID.kI = ANGULAR_KI;
-        chassis.angularPID.kD = ANGULAR_KD;
+        presetGains(LATERAL_KP, LATERAL_KI, LATERAL_KD, ANGULAR_KP, ANGULAR_KI, ANGULAR_KD);
+        break;
     case 2:
         //fast
-        chassis.lateralPID.kP = F_LATERAL_KP;
-        chassis.lateralPID.kI = F_LATERAL_KI;
-        chassis.lateralPID.kD = F_LATERAL_KD;
-        chassis.angularPID.kP = F_ANGULAR_KP;
-        chassis.angularPID.kI = F_ANGULAR_KI;
-        chassis.angularPID.kD = F_ANGULAR_KD;
+        presetGains(F_LATERAL_KP, F_LATERAL_KI, F_LATERAL_KD, F_ANGULAR_KP, F_ANGULAR_KI, F_ANGULAR_KD);
+        break;
     case 3:
         //precise
-        chassis.lateralPID.kP = P_LATERAL_KP;
-        chassis.lateralPID.kI = P_LATERAL_KI;
-        chassis.lateralPID.kD = P_LATERAL_KD;
-        chassis.angularPID.kP = P_ANGULAR_KP;
-        chassis.angularPID.kI = P_ANGULAR_KI;
-        chassis.angularPID.kD = P_ANGULAR_KD;
+        presetGains(P_LATERAL_KP, P_LATERAL_KI, P_LATERAL_KD, P_ANGULAR_KP, P_ANGULAR_KI, P_ANGULAR_KD);
+        break;
         }
     }
 void resetOdometry(pros::Distance sensor1, std::string axis, double dist1_center) {
@@ -115,4 +131,13 @@ void resetOdometry(pros::Distance sensor1, std::string axis, double dist1_center
     } else if (axis == "Y" && (std::abs(calculated_y - pose.y) < dist1_center + 3)){
         chassis.setPose(pose.x, calculated_y, pose.theta);
     }
-    }
\ No newline at end of file
+    }
+
+WaitAwaiter motionDone() {
+    return until([] { return !chassis.isInMotion(); });
+}
+
+WaitAwaiter traveled(float dist) {
+    // distTraveled is -1 once the motion has ended
+    return until([dist] { return chassis.distTraveled > dist || chassis.distTraveled == -1; });
+}
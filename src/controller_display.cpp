@@ -0,0 +1,48 @@
+#include "controller_display.hpp"
+
+ControllerDisplay controllerDisplay;
+
+void ControllerDisplay::set(int line, const char* text) {
+    if (line < 0 || line >= CONTROLLER_LINES) return;
+    // Pad with spaces so a shorter text overwrites what was there
+    char padded[CONTROLLER_COLUMNS + 1];
+    size_t length = strnlen(text, CONTROLLER_COLUMNS);
+    std::memcpy(padded, text, length);
+    std::memset(padded + length, ' ', CONTROLLER_COLUMNS - length);
+    padded[CONTROLLER_COLUMNS] = '\0';
+    std::lock_guard<pros::Mutex> lock(mutex);
+    std::memcpy(lines[line].wanted, padded, sizeof(padded));
+}
+
+void ControllerDisplay::setPriority(int line, int priority) {
+    if (line < 0 || line >= CONTROLLER_LINES) return;
+    std::lock_guard<pros::Mutex> lock(mutex);
+    lines[line].priority = priority;
+}
+
+void ControllerDisplay::update() {
+    char text[CONTROLLER_COLUMNS + 1];
+    int chosen = -1;
+    {
+        std::lock_guard<pros::Mutex> lock(mutex);
+        for (int i = 0; i < CONTROLLER_LINES; i++) {
+            Line& line = lines[i];
+            if (std::strcmp(line.wanted, line.shown) == 0) {
+                line.waiting = 0;
+                continue;
+            }
+            line.waiting++;
+            if (chosen < 0 || line.priority + line.waiting > lines[chosen].priority + lines[chosen].waiting) {
+                chosen = i;
+            }
+        }
+        if (chosen < 0) return;
+        std::memcpy(text, lines[chosen].wanted, sizeof(text));
+    }
+    // Send outside the lock; if the controller refuses, the line stays dirty and is retried next time
+    if (controller.set_text(chosen, 0, text) == PROS_ERR) return;
+    sends++;
+    std::lock_guard<pros::Mutex> lock(mutex);
+    std::memcpy(lines[chosen].shown, text, sizeof(text));
+    lines[chosen].waiting = 0;
+}
@@ -0,0 +1,78 @@
+#include "coroutines.hpp"
+
+CoScheduler* CoScheduler::current = nullptr;
+
+Routine& Routine::operator=(Routine&& other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+Routine::~Routine() {
+    if (handle) handle.destroy();
+}
+
+void WaitAwaiter::await_suspend(std::coroutine_handle<> h) {
+    CoScheduler::current->park({h, std::move(ready), wakeTime, timed});
+}
+
+void CoScheduler::spawn(Routine routine) {
+    // Routines start lazily; park the top-level handle with a wake time that has already passed
+    waiting.push_back({routine.handle, nullptr, clock(), true, true});
+    routines.push_back(std::move(routine));
+}
+
+void CoScheduler::tick() {
+    CoScheduler* previous = current;
+    current = this;
+    uint32_t time = clock();
+    // Resumed routines may park again or spawn new ones, so walk by index and only keep the still-waiting entries.
+    // A routine spawned during this tick starts immediately; one that parked during it waits for the next tick, or
+    // a loop around sleepFor(0) would never let the tick end.
+    std::vector<Waiter> stillWaiting;
+    const size_t parkedBefore = waiting.size();
+    for (size_t i = 0; i < waiting.size(); i++) {
+        Waiter& waiter = waiting[i];
+        if (i >= parkedBefore && !waiter.spawned) {
+            stillWaiting.push_back(std::move(waiter));
+            continue;
+        }
+        bool timedOut = waiter.timed && static_cast<int32_t>(time - waiter.wakeTime) >= 0;
+        bool ready = timedOut || (waiter.ready && waiter.ready());
+        if (!ready) {
+            stillWaiting.push_back(std::move(waiter));
+            continue;
+        }
+        std::coroutine_handle<> handle = waiter.handle;
+        handle.resume(); // May push to `waiting`, invalidating `waiter`
+    }
+    waiting = std::move(stillWaiting);
+    // Top-level routines own their frames; drop the ones that have run to completion
+    std::erase_if(routines, [](const Routine& routine) { return routine.done(); });
+    current = previous;
+}
+
+void CoScheduler::run(Routine routine, uint32_t period) {
+    spawn(std::move(routine));
+    uint32_t release = clock();
+    while (!idle()) {
+        tick();
+        if (!idle()) delayUntil(&release, period);
+    }
+}
+
+void CoScheduler::clear() {
+    waiting.clear();
+    routines.clear();
+}
+
+WaitAwaiter sleepFor(uint32_t ms) { return WaitAwaiter {nullptr, CoScheduler::current->now() + ms, true}; }
+
+WaitAwaiter until(std::function<bool()> condition) { return WaitAwaiter {std::move(condition), 0, false}; }
+
+WaitAwaiter until(std::function<bool()> condition, uint32_t timeout) {
+    return WaitAwaiter {std::move(condition), CoScheduler::current->now() + timeout, true};
+}
@@ -0,0 +1,97 @@
+#include "deferred_log.hpp"
+#include "serial_out.hpp"
+
+DeferredLog deferredLog;
+
+void DeferredLog::start() {
+    pros::Task::create([this] { formatLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "log_format");
+}
+
+// Same per-task ring claiming as SerialOut::write
+void DeferredLog::push(const LogRecord& record) {
+    pros::task_t self = pros::c::task_get_current();
+    for (Producer& producer : producers) {
+        pros::task_t owner = producer.task.load(std::memory_order_acquire);
+        if (owner == nullptr) {
+            if (!producer.task.compare_exchange_strong(owner, self)) {
+                if (owner != self) continue;
+            }
+            owner = self;
+        }
+        if (owner == self) {
+            producer.ring.push(&record, sizeof(record));
+            return;
+        }
+    }
+    unclaimedDrops.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DeferredLog::releaseTask() {
+    pros::task_t self = pros::c::task_get_current();
+    for (Producer& producer : producers) {
+        if (producer.task.load(std::memory_order_acquire) == self) {
+            producer.released.store(true, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+uint32_t DeferredLog::dropCount() const {
+    uint32_t drops = unclaimedDrops;
+    for (const Producer& producer : producers) drops += producer.ring.dropCount();
+    return drops;
+}
+
+static const char* levelName(uint8_t level) {
+    static const char* names[] = {"INFO", "DEBUG", "WARN", "ERROR", "FATAL"};
+    return level < 5 ? names[level] : "?";
+}
+
+static void formatRecord(const LogRecord& record) {
+    fmt::dynamic_format_arg_store<fmt::format_context> args;
+    for (int i = 0; i < record.count; i++) {
+        const LogRecord::Arg& arg = record.args[i];
+        switch (record.types[i]) {
+            case DeferredLog::INT: args.push_back(arg.i); break;
+            case DeferredLog::UINT: args.push_back(arg.u); break;
+            case DeferredLog::FLOAT: args.push_back(arg.f); break;
+            case DeferredLog::BOOL: args.push_back(arg.u != 0); break;
+            case DeferredLog::CHAR: args.push_back(static_cast<char>(arg.i)); break;
+            case DeferredLog::STRING: args.push_back(arg.s); break;
+            default: args.push_back(arg.p); break;
+        }
+    }
+    char text[256];
+    size_t length = fmt::format_to_n(text, sizeof(text), "[{}] {}: ", levelName(record.level), record.time).size;
+    if (length < sizeof(text)) {
+        length += fmt::vformat_to_n(text + length, sizeof(text) - length, record.format, args).size;
+    }
+    if (length > sizeof(text) - 1) length = sizeof(text) - 1;
+    text[length++] = '\n';
+    serialOut.write(text, length);
+}
+
+void DeferredLog::formatLoop() {
+    uint32_t reportedDrops = 0;
+    while (true) {
+        for (Producer& producer : producers) {
+            LogRecord record;
+            // Read the flag and the owner's state first: once the owner has released its ring or been deleted it
+            // pushes nothing more, so this drain empties the ring for good
+            pros::task_t owner = producer.task.load(std::memory_order_acquire);
+            bool released = producer.released.load(std::memory_order_acquire) ||
+                            (owner != nullptr && producerGone(owner));
+            while (producer.ring.pop(&record, sizeof(record)) == sizeof(record)) formatRecord(record);
+            if (released) {
+                producer.released.store(false, std::memory_order_relaxed);
+                producer.task.store(nullptr, std::memory_order_release);
+            }
+        }
+        uint32_t drops = dropCount();
+        if (drops != reportedDrops) {
+            serialOut.print("log: {} records dropped\n", drops - reportedDrops);
+            reportedDrops = drops;
+        }
+        pros::delay(LOG_FORMAT_PERIOD);
+    }
+}
@@ -0,0 +1,71 @@
+#include "device_state.hpp"
+
+Snapshot<DeviceState> deviceState;
+
+// Indexed getters instead of the *_all() variants, which return a freshly allocated std::vector per call
+static void readMotors(pros::MotorGroup& group, MotorState (&out)[3]) {
+    for (uint8_t i = 0; i < 3; i++) {
+        out[i].position = group.get_position(i);
+        out[i].velocity = group.get_actual_velocity(i);
+        out[i].temperature = group.get_temperature(i);
+        out[i].voltage = group.get_voltage(i);
+        out[i].current = group.get_current_draw(i);
+    }
+}
+
+static DistanceState readDistance(pros::Distance& sensor) {
+    return DistanceState {.distance = sensor.get(), .confidence = sensor.get_confidence()};
+}
+
+static ControllerState readController(pros::Controller& pad) {
+    ControllerState out;
+    out.leftX = pad.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X);
+    out.leftY = pad.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+    out.rightX = pad.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
+    out.rightY = pad.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y);
+    for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+        if (pad.get_digital(static_cast<pros::controller_digital_e_t>(button))) {
+            out.buttons |= 1u << (button - pros::E_CONTROLLER_DIGITAL_L1);
+        }
+    }
+    return out;
+}
+
+void updateDeviceState() {
+    static uint32_t updates = 0;
+    DeviceState state;
+    state.time = pros::millis();
+
+    readMotors(left_motors, state.left);
+    readMotors(right_motors, state.right);
+
+    state.horizontalPosition = horizontal_encoder.get_position();
+    state.horizontalVelocity = horizontal_encoder.get_velocity();
+    state.verticalPosition = vertical_encoder.get_position();
+    state.verticalVelocity = vertical_encoder.get_velocity();
+
+    state.imuRotation = imu.get_rotation();
+    state.imuHeading = imu.get_heading();
+    state.imuPitch = imu.get_pitch();
+    state.imuRoll = imu.get_roll();
+    state.imuGyroZ = imu.get_gyro_rate().z;
+    pros::imu_accel_s_t accel = imu.get_accel();
+    state.imuAccelX = accel.x;
+    state.imuAccelY = accel.y;
+
+    state.rightDist = readDistance(rightDistance);
+    state.leftDist = readDistance(leftDistance);
+    state.frontDist = readDistance(frontDistance);
+    state.backDist = readDistance(backDistance);
+
+    state.autonPot = autonSelector.get_value();
+    state.teamPotAngle = teamSelector.get_angle();
+
+    state.master = readController(controller);
+
+    state.batteryCapacity = pros::battery::get_capacity();
+    state.batteryVoltage = pros::battery::get_voltage();
+
+    state.update = ++updates;
+    deviceState.publish(state);
+}
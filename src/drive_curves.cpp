@@ -0,0 +1,149 @@
+#include "drive_curves.hpp"
+#include "robot_config.hpp"
+#include "params.hpp"
+#include <algorithm>
+#include <cmath>
+
+// --- Driver Profiles ---
+// The first entry is the default. Control points are {input, output} on the normalized [0, 1] scale.
+static const DriverProfile PROFILES[] = {
+    {"Default",
+     {.type = CurveType::EXPO, .deadband = DRIVE_CURVE_DEADBAND, .minOutput = DRIVE_CURVE_MIN_OUTPUT,
+      .gain = DRIVE_CURVE_GAIN},
+     {.type = CurveType::EXPO, .deadband = DRIVE_CURVE_DEADBAND, .minOutput = DRIVE_CURVE_MIN_OUTPUT,
+      .gain = DRIVE_CURVE_GAIN}},
+    {"Linear",
+     {.type = CurveType::LINEAR, .deadband = 3, .minOutput = 10},
+     {.type = CurveType::LINEAR, .deadband = 3, .minOutput = 10}},
+    {"Precise",
+     {.type = CurveType::SPLINE, .deadband = 5, .minOutput = 15, .points = {{0.5, 0.3}, {0.8, 0.6}}, .pointCount = 2},
+     {.type = CurveType::EXPO, .deadband = 5, .minOutput = 15, .gain = 1.03}},
+    {"Aggressive",
+     {.type = CurveType::SPLINE, .deadband = 3, .minOutput = 20, .points = {{0.3, 0.5}, {0.6, 0.85}}, .pointCount = 2},
+     {.type = CurveType::LINEAR, .deadband = 3, .minOutput = 20, .points = {{0.5, 0.35}}, .pointCount = 1}},
+};
+
+static constexpr int PROFILE_COUNT = sizeof(PROFILES) / sizeof(PROFILES[0]);
+
+TableDriveCurve throttleTable(PROFILES[0].throttle);
+TableDriveCurve steerTable(PROFILES[0].steer);
+
+static DriverProfile working = PROFILES[0];
+static int active = 0;
+static float activeSetting = 0; // `active` as a live parameter
+
+// Control points with the implied ends, sorted by input
+static size_t knots(const CurveShape& shape, CurvePoint* out) {
+    size_t count = 0;
+    out[count++] = {0, 0};
+    for (size_t i = 0; i < shape.pointCount && i < CURVE_MAX_POINTS; i++) out[count++] = shape.points[i];
+    out[count++] = {1, 1};
+    std::sort(out, out + count, [](const CurvePoint& a, const CurvePoint& b) { return a.in < b.in; });
+    return count;
+}
+
+static float linear(const CurvePoint* k, size_t count, float t) {
+    for (size_t i = 1; i < count; i++) {
+        if (t > k[i].in) continue;
+        float width = k[i].in - k[i - 1].in;
+        if (width <= 0) return k[i].out;
+        return k[i - 1].out + (k[i].out - k[i - 1].out) * (t - k[i - 1].in) / width;
+    }
+    return k[count - 1].out;
+}
+
+// Fritsch-Carlson monotone cubic Hermite interpolation
+static float spline(const CurvePoint* k, size_t count, float t) {
+    float slope[CURVE_MAX_POINTS + 1];   // Secant slopes between knots
+    float tangent[CURVE_MAX_POINTS + 2]; // Tangents at knots
+    for (size_t i = 0; i + 1 < count; i++) {
+        float width = k[i + 1].in - k[i].in;
+        slope[i] = width > 0 ? (k[i + 1].out - k[i].out) / width : 0;
+    }
+    tangent[0] = slope[0];
+    tangent[count - 1] = slope[count - 2];
+    for (size_t i = 1; i + 1 < count; i++) {
+        tangent[i] = (slope[i - 1] * slope[i] <= 0) ? 0 : (slope[i - 1] + slope[i]) / 2;
+    }
+    for (size_t i = 0; i + 1 < count; i++) {
+        if (slope[i] == 0) {
+            tangent[i] = tangent[i + 1] = 0;
+            continue;
+        }
+        float a = tangent[i] / slope[i], b = tangent[i + 1] / slope[i];
+        float length = a * a + b * b;
+        if (length > 9) {
+            float scale = 3 / std::sqrt(length);
+            tangent[i] = scale * a * slope[i];
+            tangent[i + 1] = scale * b * slope[i];
+        }
+    }
+    for (size_t i = 1; i < count; i++) {
+        if (t > k[i].in && i + 1 < count) continue;
+        float width = k[i].in - k[i - 1].in;
+        if (width <= 0) return k[i].out;
+        float u = (t - k[i - 1].in) / width, u2 = u * u, u3 = u2 * u;
+        return (2 * u3 - 3 * u2 + 1) * k[i - 1].out + (u3 - 2 * u2 + u) * width * tangent[i - 1] +
+               (-2 * u3 + 3 * u2) * k[i].out + (u3 - u2) * width * tangent[i];
+    }
+    return 1;
+}
+
+float CurveShape::evaluate(float input) const {
+    float magnitude = std::min(std::fabs(input), 127.0f);
+    if (magnitude <= deadband) return 0;
+    float range = 127 - deadband;
+    float t = (magnitude - deadband) / range;
+    float s = t;
+    if (type == CurveType::EXPO) {
+        s = t * std::pow(gain, range * (t - 1));
+    } else {
+        CurvePoint k[CURVE_MAX_POINTS + 2];
+        size_t count = knots(*this, k);
+        s = (type == CurveType::LINEAR) ? linear(k, count, t) : spline(k, count, t);
+    }
+    s = std::clamp(s, 0.0f, 1.0f);
+    return std::copysign(minOutput + (127 - minOutput) * s, input);
+}
+
+void TableDriveCurve::build(const CurveShape& shape) {
+    for (int i = 0; i < 256; i++) table[i] = shape.evaluate(i - 128);
+}
+
+float TableDriveCurve::curve(float input) {
+    int index = static_cast<int>(std::lround(input)) + 128;
+    return table[std::clamp(index, 0, 255)];
+}
+
+int driverProfileCount() { return PROFILE_COUNT; }
+
+const char* driverProfileName(int index) { return PROFILES[index].name; }
+
+int activeDriverProfile() { return active; }
+
+void selectDriverProfile(int index) {
+    active = ((index % PROFILE_COUNT) + PROFILE_COUNT) % PROFILE_COUNT;
+    activeSetting = active;
+    working = PROFILES[active];
+    rebuildDriveCurves();
+}
+
+DriverProfile& editDriverProfile() { return working; }
+
+void rebuildDriveCurves() {
+    throttleTable.build(working.throttle);
+    steerTable.build(working.steer);
+}
+
+void registerDriveCurveParams() {
+    const ParamBoundary driver = ParamBoundary::DRIVER;
+    params.add("drive.profile", &activeSetting, 0, PROFILE_COUNT - 1, driver,
+               [] { selectDriverProfile(static_cast<int>(std::lround(activeSetting))); });
+    // These edit the active profile until another one is selected
+    params.add("throttle.deadband", &working.throttle.deadband, 0, 126, driver, rebuildDriveCurves);
+    params.add("throttle.min_output", &working.throttle.minOutput, 0, 127, driver, rebuildDriveCurves);
+    params.add("throttle.gain", &working.throttle.gain, 1, 1.5, driver, rebuildDriveCurves);
+    params.add("steer.deadband", &working.steer.deadband, 0, 126, driver, rebuildDriveCurves);
+    params.add("steer.min_output", &working.steer.minOutput, 0, 127, driver, rebuildDriveCurves);
+    params.add("steer.gain", &working.steer.gain, 1, 1.5, driver, rebuildDriveCurves);
+}
@@ -0,0 +1,61 @@
+#include "driver_control.hpp"
+#include "deferred_log.hpp"
+#include <algorithm>
+
+Snapshot<DriverLatency> driverLatency;
+
+// Only the opcontrol() task touches these
+static DriverLatency totals;
+static DriverSample previous;
+static uint64_t commandSum = 0;
+static uint64_t stickSum = 0;
+
+void startDriverControl() {
+    totals = DriverLatency {};
+    previous = DriverSample {};
+    commandSum = 0;
+    stickSum = 0;
+    driverLatency.publish(totals);
+}
+
+DriverSample readDriverSample() {
+    DriverSample sample;
+    sample.throttle = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+    sample.turn = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
+    for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+        if (controller.get_digital(static_cast<pros::controller_digital_e_t>(button))) {
+            sample.buttons |= 1u << (button - pros::E_CONTROLLER_DIGITAL_L1);
+        }
+    }
+    sample.time = pros::micros();
+    return sample;
+}
+
+void driverCommandIssued(const DriverSample& sample) {
+    uint32_t now = pros::micros();
+    uint32_t command = now - sample.time;
+    totals.samples++;
+    commandSum += command;
+    totals.commandMax = std::max(totals.commandMax, command);
+    totals.commandMean = static_cast<float>(commandSum) / totals.samples;
+
+    bool moved = sample.throttle != previous.throttle || sample.turn != previous.turn;
+    if (moved && previous.time != 0) {
+        uint32_t changedAt = previous.time + (sample.time - previous.time) / 2;
+        uint32_t stick = now - changedAt;
+        totals.changes++;
+        stickSum += stick;
+        totals.stickMax = std::max(totals.stickMax, stick);
+        totals.stickMean = static_cast<float>(stickSum) / totals.changes;
+    }
+    previous = sample;
+    driverLatency.publish(totals);
+}
+
+void reportDriverLatency() {
+    DriverLatency latency = driverLatency.load();
+    if (latency.samples == 0) return;
+    LOG_INFO("driver: {} samples, command {:.0f}us mean {}us max, stick {:.0f}us mean {}us max ({} moves)",
+             latency.samples, latency.commandMean, latency.commandMax, latency.stickMean, latency.stickMax,
+             latency.changes);
+}
@@ -0,0 +1,54 @@
+#include "flight_log.hpp"
+#include <cstring>
+
+uint32_t crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+FlightLogReader::~FlightLogReader() {
+    if (file != nullptr) std::fclose(file);
+}
+
+bool FlightLogReader::open(const char* path) {
+    file = std::fopen(path, "rb");
+    if (file == nullptr) return false;
+    if (std::fread(&head, sizeof(head), 1, file) != 1 || head.magic != FLIGHT_MAGIC ||
+        head.version != FLIGHT_VERSION || head.blockSize != FLIGHT_BLOCK_SIZE) {
+        return false;
+    }
+    return std::fseek(file, head.headerSize, SEEK_SET) == 0;
+}
+
+bool FlightLogReader::loadBlock() {
+    if (std::fread(block, FLIGHT_BLOCK_SIZE, 1, file) != 1) return false;
+    FlightBlockHeader blockHead;
+    std::memcpy(&blockHead, block, sizeof(blockHead));
+    if (blockHead.magic != FLIGHT_BLOCK_MAGIC || blockHead.sequence != blockCount ||
+        blockHead.used > FLIGHT_BLOCK_SIZE - sizeof(blockHead) ||
+        crc32(block + sizeof(blockHead), blockHead.used) != blockHead.crc) {
+        return false;
+    }
+    offset = sizeof(blockHead);
+    used = sizeof(blockHead) + blockHead.used;
+    blockCount++;
+    return true;
+}
+
+bool FlightLogReader::next(uint8_t& type, uint32_t& time, uint8_t* payload, uint8_t& size) {
+    if (file == nullptr) return false;
+    while (offset + FLIGHT_RECORD_HEADER > used) {
+        if (!loadBlock()) return false;
+    }
+    type = block[offset];
+    size = block[offset + 1];
+    std::memcpy(&time, block + offset + 2, sizeof(time));
+    if (offset + FLIGHT_RECORD_HEADER + size > used) return false;
+    std::memcpy(payload, block + offset + FLIGHT_RECORD_HEADER, size);
+    offset += FLIGHT_RECORD_HEADER + size;
+    return true;
+}
@@ -0,0 +1,139 @@
+#include "flight_recorder.hpp"
+#include <cstring>
+
+// Reads the last run number from runs.idx and stores the next one, so numbering survives power cycles
+static uint32_t nextRunIndex(const char* directory) {
+    char path[96];
+    std::snprintf(path, sizeof(path), "%s/runs.idx", directory);
+    unsigned long index = 0;
+    if (std::FILE* in = std::fopen(path, "r")) {
+        if (std::fscanf(in, "%lu", &index) != 1) index = 0;
+        std::fclose(in);
+    }
+    index++;
+    if (std::FILE* out = std::fopen(path, "w")) {
+        std::fprintf(out, "%lu\n", index);
+        std::fclose(out);
+    }
+    return index;
+}
+
+bool FlightRecorder::open(const char* directory, uint32_t startTime, uint8_t auton, bool red) {
+    if (file != nullptr) return false;
+    header = FlightHeader {};
+    header.runIndex = nextRunIndex(directory);
+    header.startTime = startTime;
+    header.auton = auton;
+    header.red = red;
+
+    char path[96];
+    std::snprintf(path, sizeof(path), "%s/run_%04lu.kfr", directory, static_cast<unsigned long>(header.runIndex));
+    file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    if (!writeHeader()) {
+        std::fclose(file);
+        file = nullptr;
+        return false;
+    }
+
+    for (Block& block : blocks) {
+        block.used = sizeof(FlightBlockHeader);
+        block.records = 0;
+        block.sealed.store(false, std::memory_order_relaxed);
+    }
+    fill = 0;
+    drain = 0;
+    drops.store(0, std::memory_order_relaxed);
+    stopped.store(false, std::memory_order_relaxed);
+    recording.store(true, std::memory_order_release);
+    return true;
+}
+
+// Writes the header padded to its full size at the start of the file, then returns to the end
+bool FlightRecorder::writeHeader() {
+    uint8_t padded[FLIGHT_HEADER_SIZE] = {};
+    std::memcpy(padded, &header, sizeof(header));
+    if (std::fseek(file, 0, SEEK_SET) != 0) return false;
+    bool ok = std::fwrite(padded, sizeof(padded), 1, file) == 1;
+    std::fseek(file, 0, SEEK_END);
+    return ok;
+}
+
+void FlightRecorder::writeBlock(Block& block) {
+    FlightBlockHeader blockHead;
+    blockHead.sequence = header.blocks;
+    blockHead.used = block.used - sizeof(FlightBlockHeader);
+    blockHead.records = block.records;
+    blockHead.crc = crc32(block.data + sizeof(FlightBlockHeader), blockHead.used);
+    std::memcpy(block.data, &blockHead, sizeof(blockHead));
+    std::memset(block.data + block.used, 0, FLIGHT_BLOCK_SIZE - block.used);
+
+    if (std::fwrite(block.data, FLIGHT_BLOCK_SIZE, 1, file) == 1) {
+        header.blocks++;
+        header.records += block.records;
+    }
+    // Keep the header's counts current and push everything to the card, so a crash loses at most the blocks still
+    // in RAM
+    header.drops = drops.load(std::memory_order_relaxed);
+    writeHeader();
+    std::fflush(file);
+
+    block.used = sizeof(FlightBlockHeader);
+    block.records = 0;
+    block.sealed.store(false, std::memory_order_release);
+}
+
+void FlightRecorder::finalize() {
+    header.finalized = 1;
+    header.drops = drops.load(std::memory_order_relaxed);
+    writeHeader();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void FlightRecorder::flush() {
+    if (file == nullptr) return;
+    // Read the stop flag first: stop() seals the last block before setting it, so that block is visible below
+    bool closing = stopped.load(std::memory_order_acquire);
+    while (blocks[drain].sealed.load(std::memory_order_acquire)) {
+        writeBlock(blocks[drain]);
+        drain = (drain + 1) % FLIGHT_BUFFERS;
+    }
+    if (closing) finalize();
+}
+
+bool FlightRecorder::append(uint8_t type, uint32_t time, const void* payload, uint8_t size) {
+    if (!recording.load(std::memory_order_relaxed)) return false;
+    Block* block = &blocks[fill];
+    if (block->sealed.load(std::memory_order_acquire)) {
+        drops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    size_t length = FLIGHT_RECORD_HEADER + size;
+    if (block->used + length > FLIGHT_BLOCK_SIZE) {
+        block->sealed.store(true, std::memory_order_release);
+        fill = (fill + 1) % FLIGHT_BUFFERS;
+        block = &blocks[fill];
+        if (block->sealed.load(std::memory_order_acquire)) {
+            drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    uint8_t* out = block->data + block->used;
+    out[0] = type;
+    out[1] = size;
+    std::memcpy(out + 2, &time, sizeof(time));
+    std::memcpy(out + FLIGHT_RECORD_HEADER, payload, size);
+    block->used += length;
+    block->records++;
+    return true;
+}
+
+void FlightRecorder::stop() {
+    if (!recording.exchange(false, std::memory_order_relaxed)) return;
+    Block& block = blocks[fill];
+    if (!block.sealed.load(std::memory_order_acquire) && block.records > 0) {
+        block.sealed.store(true, std::memory_order_release);
+    }
+    stopped.store(true, std::memory_order_release);
+}
@@ -0,0 +1,89 @@
+#include "flight_recording.hpp"
+#include "robot_config.hpp"
+#include "device_state.hpp"
+#include "odom_state.hpp"
+#include "telemetry.hpp"
+#include "motion.hpp"
+#include "deferred_log.hpp"
+
+FlightRecorder flightRecorder;
+
+// Requests handed from the competition task to the recorder job and the writer task
+static std::atomic<bool> startRequested = false;
+static std::atomic<bool> stopRequested = false;
+static std::atomic<uint8_t> runAuton = 0;
+static std::atomic<bool> runRed = false;
+
+// Opens requested runs and writes sealed blocks. Runs below every control loop, so a slow card only delays logging.
+static void writerLoop() {
+    while (true) {
+        flightRecorder.flush();
+        if (!flightRecorder.isOpen() && startRequested.exchange(false)) {
+            if (!pros::usd::is_installed()) {
+                LOG_WARN("flight recorder: no SD card, run not recorded");
+            } else if (!flightRecorder.open(FLIGHT_DIRECTORY, pros::millis(), runAuton, runRed)) {
+                LOG_WARN("flight recorder: could not create a run file");
+            } else {
+                LOG_INFO("flight recorder: recording run {}", flightRecorder.runIndex());
+            }
+        }
+        pros::delay(FLIGHT_FLUSH_PERIOD);
+    }
+}
+
+void startFlightRecorder() {
+    if (!FLIGHT_RECORDER_ENABLED) return;
+    pros::Task::create(writerLoop, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "flight_writer");
+}
+
+void startFlightRecording(uint8_t auton, bool red) {
+    if (!FLIGHT_RECORDER_ENABLED) return;
+    runAuton = auton;
+    runRed = red;
+    // The writer only opens the new run once the recorder job has stopped the old one and it has been finalized
+    if (flightRecorder.isRecording()) stopRequested = true;
+    startRequested = true;
+}
+
+void stopFlightRecording() {
+    startRequested = false;
+    if (flightRecorder.isRecording()) stopRequested = true;
+}
+
+void recordFlightData() {
+    static uint32_t motionSequence = 0;
+    MotionEvent events[4];
+    uint32_t eventTimes[4];
+    if (stopRequested.exchange(false)) flightRecorder.stop();
+    if (!flightRecorder.isRecording()) {
+        while (readMotionEvents(motionSequence, events, eventTimes, 4) > 0) {} // Skip events between runs
+        return;
+    }
+
+    OdomState odom = odomState.load();
+    flightRecorder.append(FLIGHT_POSE, odom.time,
+                          PoseSample {odom.x, odom.y, odom.theta, odom.xVel, odom.yVel, odom.thetaVel});
+
+    DeviceState devices = deviceState.load();
+    MotorSample motors {};
+    for (int i = 0; i < 3; i++) {
+        const MotorState* sides[2] = {&devices.left[i], &devices.right[i]};
+        for (int side = 0; side < 2; side++) {
+            motors.velocity[side * 3 + i] = sides[side]->velocity;
+            motors.voltage[side * 3 + i] = static_cast<int16_t>(sides[side]->voltage);
+            motors.current[side * 3 + i] = static_cast<int16_t>(sides[side]->current);
+        }
+    }
+    flightRecorder.append(FLIGHT_MOTORS, devices.time, motors);
+
+    size_t count;
+    while ((count = readMotionEvents(motionSequence, events, eventTimes, 4)) > 0) {
+        for (size_t i = 0; i < count; i++) flightRecorder.append(FLIGHT_MOTION, eventTimes[i], events[i]);
+    }
+
+    if (chassis.isInMotion()) {
+        uint32_t now = pros::millis();
+        flightRecorder.append(FLIGHT_PID, now, samplePid(PID_LATERAL, chassis.lateralPID));
+        flightRecorder.append(FLIGHT_PID, now, samplePid(PID_ANGULAR, chassis.angularPID));
+    }
+}
@@ -0,0 +1,75 @@
+#include "heading_hold.hpp"
+#include "robot_config.hpp"
+#include "drive_curves.hpp"
+#include "odom_state.hpp"
+#include "params.hpp"
+#include "telemetry.hpp"
+#include "startup.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Only the opcontrol() task drives these (live parameters are applied from that task too)
+static lemlib::PID holdPID(HOLD_KP, HOLD_KI, HOLD_KD);
+static float enabledSetting = HEADING_HOLD_DEFAULT;
+static bool latched = false;
+static float target = 0; // Latched heading (degrees)
+
+void setHeadingHold(bool enabled) {
+    enabledSetting = enabled;
+    latched = false;
+}
+
+bool headingHoldEnabled() { return enabledSetting != 0; }
+
+bool headingHoldActive() { return latched; }
+
+void driveWithAssist(const DriverSample& sample) {
+    bool driving = std::abs(sample.throttle) > HOLD_THROTTLE_DEADBAND;
+    bool turning = std::abs(sample.turn) > HOLD_TURN_DEADBAND;
+    // No hold until the IMU has calibrated; the robot drives normally in the meantime
+    if (!headingHoldEnabled() || !startupReady(STARTUP_IMU) || turning || !driving) {
+        latched = false; // Release on the same iteration the driver turns or lets go
+        chassis.arcade(sample.throttle, sample.turn);
+        return;
+    }
+
+    OdomState odom = odomState.load();
+    if (!latched) {
+        // Wait for the robot to stop rotating, so the hold doesn't lock in the tail of the last turn
+        if (std::fabs(odom.thetaVel) > HOLD_LATCH_RATE) {
+            chassis.arcade(sample.throttle, sample.turn);
+            return;
+        }
+        latched = true;
+        target = odom.theta;
+        holdPID.reset();
+    }
+
+    // Headings grow clockwise, the same direction as a positive turn
+    float error = target - odom.theta;
+    float previous = holdPID.prevError;
+    const float limit = HOLD_MAX_TURN;
+    float output = std::clamp(holdPID.update(error), -limit, limit);
+    // The drive curve is bypassed so the correction is applied exactly; shape the throttle here instead
+    chassis.arcade(throttleTable.curve(sample.throttle), output, true);
+
+    if (TELEMETRY_ENABLED) {
+        telemetry.send(TELEMETRY_PID, PidSample {
+                                          .loop = PID_HEADING_HOLD,
+                                          .error = error,
+                                          .integral = holdPID.integral,
+                                          .p = holdPID.kP * error,
+                                          .i = holdPID.kI * holdPID.integral,
+                                          .d = holdPID.kD * (error - previous),
+                                          .output = output,
+                                      });
+    }
+}
+
+void registerHeadingHoldParams() {
+    const ParamBoundary driver = ParamBoundary::DRIVER;
+    params.add("hold.enabled", &enabledSetting, 0, 1, driver, [] { latched = false; });
+    params.add("hold.kp", &holdPID.kP, 0, 20, driver);
+    params.add("hold.ki", &holdPID.kI, 0, 5, driver);
+    params.add("hold.kd", &holdPID.kD, 0, 100, driver);
+}
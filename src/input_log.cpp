@@ -0,0 +1,28 @@
+#include "input_log.hpp"
+
+// Plain stdio so the same code runs on the brain (/usd/) and on a host machine
+
+bool writeInputLog(const char* path, InputLogHeader header, const std::vector<InputRecord>& records) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    header.recordSize = sizeof(InputRecord);
+    header.count = records.size();
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && !records.empty()) ok = std::fwrite(records.data(), sizeof(InputRecord), records.size(), file) == records.size();
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+bool readInputLog(const char* path, InputLogHeader& header, std::vector<InputRecord>& records) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) return false;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 && header.magic == INPUT_LOG_MAGIC &&
+              header.version == INPUT_LOG_VERSION && header.recordSize == sizeof(InputRecord);
+    if (ok) {
+        records.resize(header.count);
+        ok = std::fread(records.data(), sizeof(InputRecord), header.count, file) == header.count;
+    }
+    std::fclose(file);
+    if (!ok) records.clear();
+    return ok;
+}
@@ -0,0 +1,89 @@
+#include "input_recorder.hpp"
+#include "robot_config.hpp"
+#include "serial_out.hpp"
+#include <atomic>
+#include <cstdio>
+
+static std::vector<InputRecord> records;
+static InputLogHeader header;
+static pros::Mutex recordMutex;
+static std::atomic<bool> recording = false;
+static uint32_t lastUpdate = 0;
+static std::atomic<int> nextFile = -1; // First unused inputs_NNN.bin (-1 until scanned)
+
+static int32_t centi(float degrees) { return static_cast<int32_t>(degrees * 100); }
+
+InputRecord makeInputRecord(const DeviceState& state) {
+    InputRecord record {};
+    record.time = state.time;
+    record.horizontalPosition = state.horizontalPosition;
+    record.verticalPosition = state.verticalPosition;
+    for (int i = 0; i < 3; i++) {
+        record.leftMotorPosition[i] = centi(state.left[i].position);
+        record.rightMotorPosition[i] = centi(state.right[i].position);
+    }
+    record.imuRotation = state.imuRotation;
+    record.imuHeading = state.imuHeading;
+    record.imuGyroZ = state.imuGyroZ;
+    record.distance[0] = state.rightDist.distance;
+    record.distance[1] = state.leftDist.distance;
+    record.distance[2] = state.frontDist.distance;
+    record.distance[3] = state.backDist.distance;
+    record.sticks[0] = state.master.leftX;
+    record.sticks[1] = state.master.leftY;
+    record.sticks[2] = state.master.rightX;
+    record.sticks[3] = state.master.rightY;
+    record.buttons = state.master.buttons;
+    return record;
+}
+
+void startInputRecording(uint8_t auton, bool red) {
+    if (!INPUT_LOG_ENABLED) return;
+    std::lock_guard<pros::Mutex> lock(recordMutex);
+    // Reserve the whole buffer up front so recording never allocates inside the loop
+    records.reserve(INPUT_LOG_MAX_RECORDS);
+    records.clear();
+    header = InputLogHeader {.period = DEVICE_UPDATE_PERIOD, .auton = auton, .red = red};
+    lastUpdate = 0;
+    recording = true;
+}
+
+void stopInputRecording() {
+    if (!recording.exchange(false)) return;
+    std::lock_guard<pros::Mutex> lock(recordMutex);
+    if (records.empty() || !pros::usd::is_installed()) return;
+    // Earlier runs are never overwritten
+    int file = nextFile;
+    if (file < 0 || file >= INPUT_LOG_MAX_FILES) {
+        serialOut.print("input log: {}, run not saved\n", file < 0 ? "SD card not scanned yet" : "no file names left");
+        records.clear();
+        return;
+    }
+    char path[32];
+    std::snprintf(path, sizeof(path), "/usd/inputs_%03d.bin", file);
+    nextFile = file + 1; // Even after a failed write, which may have left part of a file behind
+    if (!writeInputLog(path, header, records)) serialOut.print("input log: failed to write {}\n", path);
+    records.clear();
+}
+
+void scanInputLogs() {
+    if (!pros::usd::is_installed()) return;
+    char path[32];
+    int file = 0;
+    for (; file < INPUT_LOG_MAX_FILES; file++) {
+        std::snprintf(path, sizeof(path), "/usd/inputs_%03d.bin", file);
+        std::FILE* existing = std::fopen(path, "rb");
+        if (existing == nullptr) break;
+        std::fclose(existing);
+    }
+    nextFile = file;
+}
+
+void recordInputs() {
+    if (!recording) return;
+    DeviceState state = deviceState.load();
+    if (state.update == lastUpdate) return; // Nothing new since the last record
+    lastUpdate = state.update;
+    std::lock_guard<pros::Mutex> lock(recordMutex);
+    if (records.size() < INPUT_LOG_MAX_RECORDS) records.push_back(makeInputRecord(state));
+}
@@ -0,0 +1,105 @@
+#include "macro.hpp"
+#include "robot_config.hpp"
+#include "drive_curves.hpp"
+#include "odom_state.hpp"
+#include "subsystems.hpp"
+#include "deferred_log.hpp"
+
+// Only the task running opcontrol()/autonomous() touches these
+static std::vector<MacroFrame> frames;
+static MacroHeader header;
+static bool recording = false;
+static bool playing = false;
+static size_t playIndex = 0;        // Next frame to play
+static int playProfile = 0;         // Driver profile to restore when playback ends
+static uint16_t playButtons = 0;    // Buttons of the previous played frame, for new presses
+
+void startMacroRecording() {
+    stopMacroPlayback(); // The recording is about to be replaced
+    // Reserve up front so recording never allocates inside the drive loop
+    frames.reserve(MACRO_MAX_FRAMES);
+    frames.clear();
+    OdomState odom = odomState.load();
+    header = MacroHeader {};
+    header.period = DRIVE_LOOP_PERIOD;
+    header.profile = activeDriverProfile();
+    header.startX = odom.x;
+    header.startY = odom.y;
+    header.startTheta = odom.theta;
+    recording = true;
+}
+
+void stopMacroRecording() { recording = false; }
+
+bool macroRecording() { return recording; }
+
+void recordMacroFrame(const DriverSample& sample) {
+    if (!recording) return;
+    if (frames.size() >= MACRO_MAX_FRAMES) {
+        recording = false;
+        LOG_WARN("macro: recording full after {} frames", frames.size());
+        return;
+    }
+    OdomState odom = odomState.load();
+    frames.push_back(makeMacroFrame(sample.throttle, sample.turn, sample.buttons, odom.x, odom.y, odom.theta));
+}
+
+bool saveMacro(const char* path) {
+    if (frames.empty() || !pros::usd::is_installed()) return false;
+    return writeMacro(path, header, frames);
+}
+
+bool loadMacro(const char* path) {
+    recording = false;
+    stopMacroPlayback();
+    return readMacro(path, header, frames, MACRO_MAX_FRAMES);
+}
+
+size_t macroFrameCount() { return frames.size(); }
+
+bool startMacroPlayback(bool resetPose) {
+    if (frames.empty()) return false;
+    recording = false;
+    // The sticks were recorded raw, so replay them through the same curves
+    if (!playing) playProfile = activeDriverProfile();
+    selectDriverProfile(header.profile);
+    if (resetPose) chassis.setPose(header.startX, header.startY, header.startTheta);
+    playing = true;
+    playIndex = 0;
+    playButtons = 0;
+    return true;
+}
+
+void stopMacroPlayback() {
+    if (!playing) return;
+    playing = false;
+    chassis.arcade(0, 0);
+    subsystemControl(0, 0);
+    selectDriverProfile(playProfile);
+}
+
+bool macroPlaying() { return playing; }
+
+bool macroPlaybackStep() {
+    if (!playing) return false;
+    if (playIndex >= frames.size()) {
+        stopMacroPlayback();
+        return false;
+    }
+    const MacroGains gains;
+    OdomState odom = odomState.load();
+    MacroCommand command = macroStep(frames, playIndex, odom.x, odom.y, odom.theta, gains);
+    chassis.arcade(command.throttle, command.turn);
+    uint16_t buttons = frames[playIndex].buttons;
+    subsystemControl(buttons, buttons & ~playButtons);
+    playButtons = buttons;
+    playIndex++;
+    return true;
+}
+
+bool playMacro(bool resetPose) {
+    if (!startMacroPlayback(resetPose)) return false;
+    uint32_t release = pros::millis();
+    while (macroPlaybackStep()) pros::Task::delay_until(&release, header.period);
+    return true;
+}
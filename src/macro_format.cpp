@@ -0,0 +1,68 @@
+#include "macro_format.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Plain stdio and math so the same code runs on the brain and on a host machine
+
+static int16_t fixed(float value, float scale) {
+    return static_cast<int16_t>(std::clamp(std::lround(value * scale), -32767l, 32767l));
+}
+
+MacroFrame makeMacroFrame(int throttle, int turn, uint16_t buttons, float x, float y, float theta) {
+    return MacroFrame {
+        .throttle = static_cast<int8_t>(std::clamp(throttle, -127, 127)),
+        .turn = static_cast<int8_t>(std::clamp(turn, -127, 127)),
+        .buttons = buttons,
+        .x = fixed(x, 100),
+        .y = fixed(y, 100),
+        .theta = fixed(theta, 10),
+    };
+}
+
+MacroCommand macroStep(const std::vector<MacroFrame>& frames, size_t index, float x, float y, float theta,
+                       const MacroGains& gains) {
+    const MacroFrame& frame = frames[index];
+    const MacroFrame& target = frames[std::min(index + gains.lookahead, frames.size() - 1)];
+
+    // Errors in the robot's frame: forward along the heading to the current frame's pose (how far behind or ahead the
+    // robot is now), lateral positive to the right to the lookahead pose (where to steer)
+    float radians = theta * static_cast<float>(M_PI) / 180;
+    float sin = std::sin(radians), cos = std::cos(radians);
+    float forward = (frameX(frame) - x) * sin + (frameY(frame) - y) * cos;
+    float lateral = (frameX(target) - x) * cos - (frameY(target) - y) * sin;
+    float heading = std::remainder(frameTheta(frame) - theta, 360.0f);
+
+    // Steering toward a point to the right means turning right when driving forward, left when reversing
+    float direction = frame.throttle < 0 ? -1 : 1;
+    float throttle = frame.throttle + gains.along * forward;
+    float turn = frame.turn + gains.heading * heading + gains.lateral * lateral * direction;
+    return MacroCommand {
+        std::clamp(static_cast<int>(std::lround(throttle)), -127, 127),
+        std::clamp(static_cast<int>(std::lround(turn)), -127, 127),
+    };
+}
+
+bool writeMacro(const char* path, MacroHeader header, const std::vector<MacroFrame>& frames) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    header.count = frames.size();
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && !frames.empty()) ok = std::fwrite(frames.data(), sizeof(MacroFrame), frames.size(), file) == frames.size();
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+bool readMacro(const char* path, MacroHeader& header, std::vector<MacroFrame>& frames, size_t maxFrames) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) return false;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 && header.magic == MACRO_MAGIC &&
+              header.version == MACRO_VERSION && header.count <= maxFrames;
+    if (ok) {
+        frames.resize(header.count);
+        ok = std::fread(frames.data(), sizeof(MacroFrame), header.count, file) == header.count;
+    }
+    std::fclose(file);
+    if (!ok) frames.clear();
+    return ok;
+}
@@ -3,7 +3,25 @@
 #include "robot_config.hpp"
 #include "autons.hpp"
 #include "subsystems.hpp"
-#include <map>
+#include "scheduler.hpp"
+#include "odom_state.hpp"
+#include "device_state.hpp"
+#include "input_recorder.hpp"
+#include "flight_recording.hpp"
+#include "motion.hpp"
+#include "profiler.hpp"
+#include "watchdog.hpp"
+#include "telemetry.hpp"
+#include "serial_out.hpp"
+#include "deferred_log.hpp"
+#include "params.hpp"
+#include "drive_curves.hpp"
+#include "driver_control.hpp"
+#include "heading_hold.hpp"
+#include "macro.hpp"
+#include "controller_display.hpp"
+#include "auton_registry.hpp"
+#include "startup.hpp"
 #include <string>
 
 // --- Controller Definition ---
@@ -43,15 +61,14 @@ lemlib::OdomSensors sensors(&vertical_tracking_wheel, nullptr, &horizontal_track
 lemlib::ControllerSettings lateral_controller(LATERAL_KP, LATERAL_KI, LATERAL_KD, LATERAL_ANTI_WINDUP, LATERAL_SML_ERR, LATERAL_SML_TIMEOUT, LATERAL_LRG_ERR, LATERAL_LRG_TIMEOUT, LATERAL_SLEW);
 lemlib::ControllerSettings angular_controller(ANGULAR_KP, ANGULAR_KI, ANGULAR_KD, ANGULAR_ANTI_WINDUP, ANGULAR_SML_ERR, ANGULAR_SML_TIMEOUT, ANGULAR_LRG_ERR, ANGULAR_LRG_TIMEOUT, ANGULAR_SLEW);
 
-// Input Curve for throttle/steer input during driver control
-lemlib::ExpoDriveCurve drive_curve(3, 20, 1.02);
-
 // Chassis definition: Integrates all components
-lemlib::Chassis chassis(drivetrain, lateral_controller, angular_controller, sensors, &drive_curve, &drive_curve);
+// Throttle/steer input curves come from the selected driver profile (drive_curves.hpp)
+lemlib::Chassis chassis(drivetrain, lateral_controller, angular_controller, sensors, &throttleTable, &steerTable);
 
 // Global Variables
 int selectedAuton = 1;
 std::string teamtype = "RED";
+int driveLoopWatchdog = -1; // Watchdog id of the opcontrol() driving loop
 
 // Runs initialization code.
 void initialize() {
@@ -59,63 +76,100 @@ void initialize() {
     left_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
     right_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
 
-    // Reset odometry encoder positions
-    horizontal_encoder.reset_position();
-    vertical_encoder.reset_position();
-
-    pros::lcd::initialize(); // Initialize the VEX LCD (for basic prints)
-    chassis.calibrate();     // Calibrate the odometry sensors (IMU, encoders)
-    while (imu.is_calibrating()) {pros::delay(10);} imu.reset(); // Reset to 0 after calibrated
-    
-    // Create a task to continuously print robot pose (X, Y, Theta) to the brain screen
-    pros::Task update_odom([&]() {
-        while (true) {
-            // Print robot location to the brain screen
-            pros::screen::print(pros::E_TEXT_MEDIUM, 0, "X: %f", chassis.getPose().x);      // X coordinate
-            pros::screen::print(pros::E_TEXT_MEDIUM, 1, "Y: %f", chassis.getPose().y);      // Y coordinate
-            pros::screen::print(pros::E_TEXT_MEDIUM, 2, "Theta: %f", chassis.getPose().theta); // Heading (angle)
-            pros::delay(25); // Small delay to save resources and prevent blocking
-        }
+    // IMU calibration, encoder resets, device checks, path parsing and the LCD come up in parallel (startup.hpp);
+    // nothing below waits for them
+    startStartup();
+
+    // Read every device once per tick; everything below reads the snapshot instead of the devices
+    scheduler.addJob("device_update", DEVICE_UPDATE_PERIOD, updateDeviceState);
+    // Record every snapshot while a recording is active (see input_recorder.hpp)
+    scheduler.addJob("input_record", DEVICE_UPDATE_PERIOD, recordInputs);
+    // Sample pose, motors and PID terms into the flight recorder's RAM blocks (see flight_recording.hpp)
+    scheduler.addJob("flight_record", FLIGHT_RECORD_PERIOD, recordFlightData);
+    // Wake tasks waiting on motion handles as soon as the chassis finishes a motion
+    scheduler.addJob("motion_monitor", MOTION_MONITOR_PERIOD, updateMotionHandles);
+    // Watch the critical loops and slow down background jobs when they overrun
+    scheduler.addJob("watchdog", WATCHDOG_PERIOD, watchdogUpdate);
+    driveLoopWatchdog = watchdogRegister("drive_loop", DRIVE_LOOP_PERIOD);
+    // Publish one consistent odometry snapshot per tick for every other task to read
+    scheduler.addJob("odom_publish", ODOM_PUBLISH_PERIOD, publishOdomState);
+    // Gains and exit thresholds changed over serial (see params.hpp) apply as the next motion starts
+    registerParams();
+    // Print robot pose (X, Y, Theta) to the brain screen
+    scheduler.addBackgroundJob("pose_display", POSE_DISPLAY_PERIOD, [] {
+        OdomState state = odomState.load();
+        pros::screen::print(pros::E_TEXT_MEDIUM, 0, "X: %f", state.x);         // X coordinate
+        pros::screen::print(pros::E_TEXT_MEDIUM, 1, "Y: %f", state.y);         // Y coordinate
+        pros::screen::print(pros::E_TEXT_MEDIUM, 2, "Theta: %f", state.theta); // Heading (angle)
     });
-    // Create a task to continuously print robot temp, battery, auton to the controller screen
-    pros::Task robot_info([&]() {
-        while (true) {
-            // Print Current Battery Level
-            controller.print(0, 0, "Battery: %f", pros::battery::get_capacity()); 
-            // Print Avg temp of motors
-            controller.print(1, 0, "DT Temp: %f", ((left_motors.get_temperature() + right_motors.get_temperature()) / 2)); 
-            pros::delay(5000); // Delay to save resources and prevent blocking
-        }
+    // Print robot temp, battery, auton to the controller screen
+    scheduler.addBackgroundJob("controller_info", CONTROLLER_INFO_PERIOD, [] {
+        DeviceState state = deviceState.load();
+        // Print Current Battery Level
+        controllerDisplay.print(0, "Battery: {:.0f}%", state.batteryCapacity);
+        // Print Avg temp of motors
+        controllerDisplay.print(1, "DT Temp: {:.0f}C", state.driveTemperature());
     });
+    // Send changed controller screen lines at the rate the controller accepts; line 2 (status) goes first
+    controllerDisplay.setPriority(2, 1);
+    scheduler.addBackgroundJob("controller_display", CONTROLLER_DISPLAY_PERIOD, [] { controllerDisplay.update(); });
+    // Report stick-to-command latency while driving
+    scheduler.addBackgroundJob("driver_report", DRIVER_REPORT_PERIOD, reportDriverLatency);
+    // Dump per-job timing to the terminal so loop budgets can be checked under load
+    if (SCHEDULER_REPORT_PERIOD > 0) {
+        scheduler.addBackgroundJob("sched_report", SCHEDULER_REPORT_PERIOD, [] { scheduler.printStats(); });
+    }
+    // Drain queued log text and telemetry to the terminal
+    serialOut.start();
+    deferredLog.start(); // Formats LOG_* records in the background
+    startFlightRecorder(); // Writes flight recorder blocks to the SD card in the background
+    startParamServer();    // Reads parameter commands from the terminal
+    // Stream binary telemetry to the host
+    if (TELEMETRY_ENABLED) {
+        telemetry.begin();
+        scheduler.addBackgroundJob("telemetry", TELEMETRY_PERIOD, telemetryUpdate);
+    }
+    if (PROFILING_ENABLED) {
+        startProfiler();
+        scheduler.addBackgroundJob("profile_report", PROFILE_REPORT_PERIOD, printProfile);
+    }
+    scheduler.start();
 }
 
 // Runs while the robot is in the disabled state.
 void disabled() {
+    stopInputRecording(); // Save the inputs of the match phase that just ended
+    stopFlightRecording();
+    if (macroRecording()) {
+        stopMacroRecording();
+        saveMacro(); // Keep the macro recorded during driver control
+    }
+    watchdogDisarm(driveLoopWatchdog); // The driving loop is stopped on purpose
     left_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
     right_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
 }
 
 // Runs after initialize(), and before autonomous() or opcontrol().
 void competition_initialize() {
+    waitForStartup(STARTUP_UI | STARTUP_PATHS); // A few ms at most; the selection below reuses the parsed paths
     pros::screen::erase(); // Clear the screen initially for a clean display
-    // This map defines the names of your autonomous routines.
-    std::map<int, std::string> auton_map = {
-        {1, "Auton1"}, {2, "Auton2"}, {3, "Auton3"}, {4, "Auton4"}, {5, "Auton5"},
-        {6, "Auton6"}, {7, "Auton7"}, {8, "Auton8"}, {9, "Auton9"}, {10, "Auton10"},
-    };
     while (pros::competition::is_disabled()) {
         // Read potentiometer values to determine selection
-        int potValue = autonSelector.get_value();
-        // Determine selected autonomous routine
-        selectedAuton = (potValue < 0) ? 1 : (potValue > 329) ? 10 : (potValue / 33) + 1;
+        DeviceState state = deviceState.load();
+        // Determine selected autonomous routine (see AUTONS in autons.cpp)
+        selectedAuton = autonFromPot(state.autonPot);
         // Determine team type based on teamSelector potentiometer's angle
-        teamtype = (teamSelector.get_angle() >= 0 && teamSelector.get_angle() <= 165) ? "RED" : "BLUE";
+        teamtype = (state.teamPotAngle >= 0 && state.teamPotAngle <= 165) ? "RED" : "BLUE";
+        // Parse paths and run setup for the selection once the pot has settled
+        updateAutonSelection(selectedAuton);
+        const AutonDescriptor& auton = autonDescriptor(selectedAuton);
         // Display selected autonomous routine description on the screen
-        pros::screen::print(pros::E_TEXT_MEDIUM, 5, "%s", ("Autonomous: " + auton_map[selectedAuton]).c_str());
+        pros::screen::print(pros::E_TEXT_MEDIUM, 5, "Autonomous: %-12s%-7s%s", auton.name, autonSideName(auton.side),
+                            autonPrepared(selectedAuton) ? "" : " (preparing)");
         // Display selected team type
-        pros::screen::print(pros::E_TEXT_MEDIUM, 6, "%s", ("Team: " + teamtype).c_str()); 
+        pros::screen::print(pros::E_TEXT_MEDIUM, 6, "Team: %-5s", teamtype.c_str());
         // Display on Contoller screen
-        controller.print(2, 0, "%s :: %s",teamtype.c_str(),  auton_map[selectedAuton].c_str());
+        controllerDisplay.print(2, "{} :: {}", teamtype, auton.name);
         // Add a small delay to control update rate and prevent CPU hogging.
         pros::delay(200);
     }
@@ -123,37 +177,19 @@ void competition_initialize() {
 
 // Runs the user autonomous code.
 void autonomous() {
-    horizontal_encoder.reset_position();
-    vertical_encoder.reset_position();
-    imu.reset();
+    // Setup that takes time (IMU calibration, path parsing) normally finished before the match; only an auton
+    // started right after power-on waits here
+    waitForStartup(STARTUP_ALL);
+    // Check the selector pot against where the robot actually sits, and take the exact start position from the walls
+    StartDetection start = detectStart(selectedAuton, teamtype == "RED");
+    selectedAuton = start.selection;
     left_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_HOLD);
     right_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_HOLD);
-    // Select and run the chosen autonomous routine based on 'autonSelect' variable.
-    // (0 = blue side auton, 1 = red side auton, or specific routine index)
-    switch (selectedAuton) {
-        case 1:
-            auton1(); break;
-        case 2:
-            auton2(); break;
-        case 3:
-            auton3(); break;
-        case 4:
-            auton4(); break;
-        case 5:
-            auton5(); break;
-        case 6:
-            auton6(); break;
-        case 7:
-            auton7(); break;
-        case 8:
-            auton8(); break;
-        case 9:
-            auton9(); break;
-        case 10:
-            auton10(); break;
-        default:
-            auton1(); break;
-    }
+    startInputRecording(selectedAuton, teamtype == "RED");
+    startFlightRecording(selectedAuton, teamtype == "RED");
+    autonRuntime.clear(); // Drop routines left over from an auton that was cut short
+    // Set the start pose and run the routine
+    runAuton(selectedAuton, start.pose);
 }
 
 
@@ -161,17 +197,64 @@ void autonomous() {
 void opcontrol() {
     left_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
     right_motors.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
+    startInputRecording(0, teamtype == "RED");
+    startFlightRecording(0, teamtype == "RED");
+    startDriverControl();
+    stopMacroPlayback(); // Playback cut short by a disable doesn't carry into the next driver period
+    uint16_t previousButtons = 0;
+    uint32_t release = pros::millis();
     while (true) {
-        // --- Driving Control (Arcade Style) ---
-        // Get joystick values for left Y-axis (forward/backward) and right X-axis (turning)
-        int leftY = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
-        int rightX = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
+        {
+            PROFILE_SCOPE("drive_loop"); // Covers the loop body, not the wait below
+            watchdogBeat(driveLoopWatchdog);
+            params.apply(ParamBoundary::DRIVER); // Drive curve changes land between iterations
+            // Cycle through driver profiles
+            int profileStep = controller.get_digital_new_press(DRIVER_PROFILE_NEXT_BUTTON) -
+                              controller.get_digital_new_press(DRIVER_PROFILE_PREV_BUTTON);
+            if (profileStep != 0) {
+                selectDriverProfile(activeDriverProfile() + profileStep);
+                controllerDisplay.print(2, "Drive: {}", driverProfileName(activeDriverProfile()));
+            }
+            // Toggle the heading hold assist
+            if (controller.get_digital_new_press(HEADING_HOLD_BUTTON)) {
+                setHeadingHold(!headingHoldEnabled());
+                controllerDisplay.print(2, "Hold: {}", headingHoldEnabled() ? "ON" : "OFF");
+            }
+            // Record a driver macro, or play the last one back (moving a stick or pressing play again stops playback).
+            // Both wait for the saved macro to load at startup (STARTUP_PATHS), as it replaces the one in RAM.
+            if (controller.get_digital_new_press(MACRO_RECORD_BUTTON) && startupReady(STARTUP_PATHS)) {
+                macroRecording() ? stopMacroRecording() : startMacroRecording();
+                controllerDisplay.print(2, "Macro: {}", macroRecording() ? "REC" : "STOPPED");
+            }
+            // Playback steers by odometry, so it waits for the IMU; plain driving never does
+            if (controller.get_digital_new_press(MACRO_PLAY_BUTTON) && !macroRecording()) {
+                if (macroPlaying()) {
+                    stopMacroPlayback();
+                } else if (startupReady(STARTUP_IMU | STARTUP_PATHS) && startMacroPlayback()) {
+                    controllerDisplay.print(2, "Macro: PLAY");
+                }
+            }
+            // --- Driving Control (Arcade Style) ---
+            // Read the sticks last so the sample is as fresh as possible when the command goes out
+            DriverSample sample = readDriverSample();
+            if (macroPlaying() &&
+                (std::abs(sample.throttle) > MACRO_ABORT_STICK || std::abs(sample.turn) > MACRO_ABORT_STICK)) {
+                stopMacroPlayback();
+            }
 
-        // Control the chassis using arcade drive
-        // 'leftY' controls forward/backward, 'rightX' controls turning
-        chassis.arcade(leftY, rightX);
+            // Control the chassis using arcade drive (with heading hold when enabled)
+            // Left Y controls forward/backward, right X controls turning
+            if (!macroPlaybackStep()) {
+                driveWithAssist(sample);
+                driverCommandIssued(sample);
+                subsystemControl(sample.buttons, sample.buttons & ~previousButtons);
+                recordMacroFrame(sample);
+            }
+            previousButtons = sample.buttons;
+        }
 
-        // A small delay to yield control to other PROS tasks and reduce CPU usage.
-        pros::delay(25);
+        // Wait for the next period; delay_until keeps the loop rate fixed regardless of how long the body took,
+        // and the period matches the motors' command cadence.
+        pros::Task::delay_until(&release, DRIVE_LOOP_PERIOD);
     }
 }
@@ -0,0 +1,247 @@
+#include "motion.hpp"
+#include "params.hpp"
+#include "path_cache.hpp"
+#include <algorithm>
+#include <cmath>
+
+#define MOTION_EVENT_HISTORY 16
+
+// A task blocked on a handle, waiting for the motion to travel `dist` (-1: only for it to end)
+struct MotionWaiter {
+    pros::task_t task;
+    float dist;
+};
+
+// Shared between the handle(s) and the monitor job
+struct MotionState {
+    MotionEvent event {}; // Start event; the end event is built from it
+    std::atomic<bool> done = false;
+    std::atomic<bool> cancelled = false;
+    std::atomic<float> progress = 0;
+    std::atomic<float> notifyAt = -1; // Nearest distance a waitUntil() caller still waits for (-1 when none)
+    uint32_t startTime = 0;
+    std::atomic<uint32_t> endTime = 0;
+
+    pros::Mutex mutex; // Guards `waiters` and updates of `notifyAt`
+    std::vector<MotionWaiter> waiters;
+};
+
+static pros::Mutex currentMutex;
+static std::shared_ptr<MotionState> current; // Motion the chassis is running, if any
+
+// Recent start/end events for the flight recorder
+static pros::Mutex eventMutex;
+static MotionEvent events[MOTION_EVENT_HISTORY];
+static uint32_t eventTimes[MOTION_EVENT_HISTORY];
+static uint32_t eventCount = 0;
+
+static void pushEvent(const MotionEvent& event, uint32_t time) {
+    std::lock_guard<pros::Mutex> lock(eventMutex);
+    events[eventCount % MOTION_EVENT_HISTORY] = event;
+    eventTimes[eventCount % MOTION_EVENT_HISTORY] = time;
+    eventCount++;
+}
+
+size_t readMotionEvents(uint32_t& sequence, MotionEvent* out, uint32_t* times, size_t max) {
+    std::lock_guard<pros::Mutex> lock(eventMutex);
+    if (eventCount - sequence > MOTION_EVENT_HISTORY) sequence = eventCount - MOTION_EVENT_HISTORY;
+    size_t count = 0;
+    for (; sequence != eventCount && count < max; sequence++, count++) {
+        out[count] = events[sequence % MOTION_EVENT_HISTORY];
+        times[count] = eventTimes[sequence % MOTION_EVENT_HISTORY];
+    }
+    return count;
+}
+
+// Marks the motion finished and wakes everything blocked on it
+static void finish(MotionState& state) {
+    if (state.done.exchange(true)) return;
+    state.endTime = pros::millis();
+    MotionEvent end = state.event;
+    end.phase = MOTION_END;
+    end.cancelled = state.cancelled;
+    end.progress = state.progress;
+    pushEvent(end, state.endTime);
+    std::lock_guard<pros::Mutex> lock(state.mutex);
+    for (const MotionWaiter& waiter : state.waiters) pros::c::task_notify(waiter.task);
+    state.waiters.clear();
+}
+
+// Moves `notifyAt` to the nearest distance still pending. Call with state.mutex held.
+static void updateNotifyAt(MotionState& state) {
+    float next = -1;
+    for (const MotionWaiter& waiter : state.waiters) {
+        if (waiter.dist >= state.progress && (next < 0 || waiter.dist < next)) next = waiter.dist;
+    }
+    state.notifyAt = next;
+}
+
+// Wakes the waiters whose distance the motion has passed
+static void wakeReached(MotionState& state) {
+    std::lock_guard<pros::Mutex> lock(state.mutex);
+    for (const MotionWaiter& waiter : state.waiters) {
+        if (waiter.dist >= 0 && state.progress > waiter.dist) pros::c::task_notify(waiter.task);
+    }
+    updateNotifyAt(state);
+}
+
+// True once the chassis is no longer running `state`'s motion, given the distance it reports now. A chained motion
+// takes over without isInMotion() ever going false, and the next one zeroes distTraveled before its wrapper gets to
+// startMotion(), so the handoff shows as -1 or as the distance starting over. A turn's distance is its angle from the
+// start, which dips while it settles, so only a drop back toward zero counts for turns and swings.
+static bool motionEnded(const MotionState& state, float traveled) {
+    if (traveled < 0 || !chassis.isInMotion()) return true;
+    switch (state.event.kind) {
+        case MOTION_MOVE_TO_POSE:
+        case MOTION_MOVE_TO_POINT:
+        case MOTION_FOLLOW: return traveled < state.progress;
+        default: return traveled < state.progress / 2;
+    }
+}
+
+// Ends the tracked motion. Call with currentMutex held.
+static void endCurrent(const std::shared_ptr<MotionState>& state) {
+    finish(*state);
+    if (current == state) current.reset();
+}
+
+// Called right after a chassis motion function returns, once the new motion owns the chassis (LemLib returns about
+// 10 ms after its task started). The monitor normally ended the previous motion at the handoff already.
+MotionHandle startMotion(MotionKind kind, float x, float y, float theta, int timeout) {
+    static uint32_t nextId = 0;
+    auto state = std::make_shared<MotionState>();
+    state->startTime = pros::millis();
+    state->event = MotionEvent {.kind = kind, .targetX = x, .targetY = y, .targetTheta = theta, .timeout = timeout};
+    std::lock_guard<pros::Mutex> lock(currentMutex);
+    if (current) finish(*current);
+    state->event.id = nextId++;
+    pushEvent(state->event, state->startTime);
+    current = state;
+    return MotionHandle(state);
+}
+
+void updateMotionHandles() {
+    {
+        // Held throughout so cancel() and startMotion() never see a half-updated state
+        std::lock_guard<pros::Mutex> lock(currentMutex);
+        std::shared_ptr<MotionState> state = current;
+        if (!state || state->done) return;
+        float traveled = chassis.distTraveled;
+        if (!motionEnded(*state, traveled)) {
+            state->progress = traveled;
+            if (state->notifyAt >= 0 && traveled > state->notifyAt) wakeReached(*state);
+            return;
+        }
+        endCurrent(state); // Keeps the last distance of its own; `traveled` may already be the next motion's
+    }
+    // The motion boundary of a chain (params.hpp): the next motion is at most one iteration in. This job runs below
+    // LemLib's motion tasks, so on the brain's single core it only runs while the motion loop sleeps between
+    // iterations, and the loop sees all of the new values or none.
+    params.apply(ParamBoundary::MOTION);
+}
+
+bool MotionHandle::done() const { return !state || state->done; }
+
+bool MotionHandle::cancelled() const { return state && state->cancelled; }
+
+float MotionHandle::progress() const { return state ? state->progress.load() : 0; }
+
+uint32_t MotionHandle::elapsed() const {
+    if (!state) return 0;
+    return (state->done ? state->endTime.load() : pros::millis()) - state->startTime;
+}
+
+void MotionHandle::cancel() {
+    if (!state || state->done) return;
+    std::lock_guard<pros::Mutex> lock(currentMutex);
+    if (current != state || state->done) return;
+    // Already handed over to the next motion, which the monitor hasn't noticed yet; cancelling now would stop that one
+    if (motionEnded(*state, chassis.distTraveled)) {
+        endCurrent(state);
+        return;
+    }
+    state->cancelled = true;
+    chassis.cancelMotion();
+    endCurrent(state);
+}
+
+bool MotionHandle::wait(uint32_t timeout) const { return waitUntil(-1, timeout) || done(); }
+
+bool MotionHandle::waitUntil(float dist, uint32_t timeout) const {
+    if (!state) return true;
+    auto reached = [&] { return state->done || (dist >= 0 && state->progress > dist); };
+    pros::task_t self = pros::c::task_get_current();
+    {
+        std::lock_guard<pros::Mutex> lock(state->mutex);
+        if (reached()) return dist < 0 || state->progress > dist;
+        state->waiters.push_back({self, dist});
+        updateNotifyAt(*state);
+    }
+    uint32_t deadline = (timeout == TIMEOUT_MAX) ? TIMEOUT_MAX : pros::millis() + timeout;
+    // Sleep on the task notification; loop because other code may also notify this task
+    while (!reached()) {
+        uint32_t now = pros::millis();
+        if (deadline != TIMEOUT_MAX && static_cast<int32_t>(deadline - now) <= 0) break;
+        pros::Task::notify_take(true, deadline == TIMEOUT_MAX ? TIMEOUT_MAX : deadline - now);
+    }
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    std::erase_if(state->waiters, [&](const MotionWaiter& waiter) { return waiter.task == self; });
+    updateNotifyAt(*state);
+    return dist < 0 ? state->done.load() : state->progress > dist;
+}
+
+WaitAwaiter MotionHandle::operator co_await() const {
+    return until([state = state] { return !state || state->done; });
+}
+
+// Every wrapper applies committed parameter changes first (params.hpp): the chassis is idle unless a queued motion is
+// still running, and only this task could start another one
+namespace motion {
+MotionHandle turnToPoint(float x, float y, int timeout, lemlib::TurnToPointParams params) {
+    applyMotionParams();
+    chassis.turnToPoint(x, y, timeout, params, true);
+    return startMotion(MOTION_TURN_TO_POINT, x, y, NAN, timeout);
+}
+
+MotionHandle turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params) {
+    applyMotionParams();
+    chassis.turnToHeading(theta, timeout, params, true);
+    return startMotion(MOTION_TURN_TO_HEADING, NAN, NAN, theta, timeout);
+}
+
+MotionHandle swingToHeading(float theta, lemlib::DriveSide lockedSide, int timeout,
+                            lemlib::SwingToHeadingParams params) {
+    applyMotionParams();
+    chassis.swingToHeading(theta, lockedSide, timeout, params, true);
+    return startMotion(MOTION_SWING_TO_HEADING, NAN, NAN, theta, timeout);
+}
+
+MotionHandle swingToPoint(float x, float y, lemlib::DriveSide lockedSide, int timeout,
+                          lemlib::SwingToPointParams params) {
+    applyMotionParams();
+    chassis.swingToPoint(x, y, lockedSide, timeout, params, true);
+    return startMotion(MOTION_SWING_TO_POINT, x, y, NAN, timeout);
+}
+
+MotionHandle moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params) {
+    applyMotionParams();
+    chassis.moveToPose(x, y, theta, timeout, params, true);
+    return startMotion(MOTION_MOVE_TO_POSE, x, y, theta, timeout);
+}
+
+MotionHandle moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params) {
+    applyMotionParams();
+    chassis.moveToPoint(x, y, timeout, params, true);
+    return startMotion(MOTION_MOVE_TO_POINT, x, y, NAN, timeout);
+}
+
+MotionHandle follow(const asset& path, float lookahead, int timeout, bool forwards) {
+    applyMotionParams();
+    chassis.follow(path, lookahead, timeout, forwards, true);
+    // The end point is only known if the path was prepared ahead of time; never parse here
+    const PreparedPath* prepared = findPreparedPath(path);
+    if (prepared == nullptr) return startMotion(MOTION_FOLLOW, NAN, NAN, NAN, timeout);
+    const PathPoint& end = prepared->points[prepared->end];
+    return startMotion(MOTION_FOLLOW, end.x, end.y, NAN, timeout);
+}
+} // namespace motion
@@ -0,0 +1,20 @@
+#include "odom_state.hpp"
+#include "lemlib/chassis/odom.hpp"
+
+Snapshot<OdomState> odomState;
+
+void publishOdomState() {
+    static uint32_t updates = 0;
+    lemlib::Pose pose = chassis.getPose();
+    lemlib::Pose speed = lemlib::getSpeed();
+    odomState.publish(OdomState {
+        .x = pose.x,
+        .y = pose.y,
+        .theta = pose.theta,
+        .xVel = speed.x,
+        .yVel = speed.y,
+        .thetaVel = speed.theta,
+        .time = pros::millis(),
+        .update = ++updates,
+    });
+}
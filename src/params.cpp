@@ -0,0 +1,133 @@
+#include "params.hpp"
+#include "serial_out.hpp"
+#include <cstdlib>
+#include <cstring>
+
+ParamRegistry params;
+
+int ParamRegistry::add(const char* name, float* value, float min, float max, ParamBoundary boundary,
+                       std::function<void()> onApply) {
+    if (count >= PARAM_MAX) return -1;
+    Param& param = params[count];
+    param.name = name;
+    param.value = value;
+    param.min = min;
+    param.max = max;
+    param.boundary = boundary;
+    param.onApply = std::move(onApply);
+    return count++;
+}
+
+int ParamRegistry::find(const char* key) const {
+    char* end;
+    long id = std::strtol(key, &end, 10);
+    if (end != key && *end == '\0') return (id >= 0 && id < count) ? static_cast<int>(id) : -1;
+    for (int i = 0; i < count; i++) {
+        if (std::strcmp(params[i].name, key) == 0) return i;
+    }
+    return -1;
+}
+
+bool ParamRegistry::stage(int id, float value) {
+    if (id < 0 || id >= count) return false;
+    Param& param = params[id];
+    if (!(value >= param.min && value <= param.max)) return false;
+    param.staged.store(value, std::memory_order_relaxed);
+    param.state.store(STAGED, std::memory_order_release);
+    return true;
+}
+
+int ParamRegistry::commit() {
+    int committed = 0;
+    for (int i = 0; i < count; i++) {
+        uint8_t expected = STAGED;
+        if (params[i].state.compare_exchange_strong(expected, COMMITTED, std::memory_order_acq_rel)) committed++;
+    }
+    return committed;
+}
+
+void ParamRegistry::apply(ParamBoundary boundary) {
+    for (int i = 0; i < count; i++) {
+        Param& param = params[i];
+        if (param.boundary != boundary) continue;
+        uint8_t expected = COMMITTED;
+        // A value staged again after the commit waits for the next commit
+        if (!param.state.compare_exchange_strong(expected, CLEAN, std::memory_order_acq_rel)) continue;
+        *param.value = param.staged.load(std::memory_order_relaxed);
+        param.tuned.store(true, std::memory_order_relaxed);
+        if (param.onApply) param.onApply();
+    }
+}
+
+bool ParamRegistry::preset(const char* name, float value) {
+    int id = find(name);
+    if (id < 0) return false;
+    Param& param = params[id];
+    if (param.tuned.load(std::memory_order_relaxed)) return true;
+    *param.value = value;
+    if (param.onApply) param.onApply();
+    return true;
+}
+
+void applyMotionParams() {
+    if (!chassis.isInMotion()) params.apply(ParamBoundary::MOTION);
+}
+
+// Runs one command line and queues the reply
+static void handleCommand(char* line) {
+    char* command = std::strtok(line, " \t");
+    if (command == nullptr) return;
+    char* key = std::strtok(nullptr, " \t");
+    char* text = std::strtok(nullptr, " \t");
+
+    if (std::strcmp(command, "L") == 0) {
+        for (int id = 0; id < params.size(); id++) {
+            serialOut.print("$P {} {} {} {} {}\n", id, params.name(id), params.value(id), params.min(id),
+                            params.max(id));
+        }
+        serialOut.print("$E\n");
+    } else if (std::strcmp(command, "C") == 0) {
+        serialOut.print("$C {}\n", params.commit());
+    } else if ((std::strcmp(command, "G") == 0 || std::strcmp(command, "S") == 0) && key != nullptr) {
+        int id = params.find(key);
+        if (id < 0) {
+            serialOut.print("$ERR unknown parameter {}\n", key);
+        } else if (command[0] == 'G') {
+            serialOut.print("$V {} {}\n", id, params.value(id));
+        } else {
+            char* end = nullptr;
+            float value = text ? std::strtof(text, &end) : 0;
+            if (text == nullptr || *end != '\0') {
+                serialOut.print("$ERR bad value\n");
+            } else if (!params.stage(id, value)) {
+                serialOut.print("$ERR {} outside [{}, {}]\n", value, params.min(id), params.max(id));
+            } else {
+                serialOut.print("$S {} {}\n", id, value);
+            }
+        }
+    } else {
+        serialOut.print("$ERR bad command\n");
+    }
+}
+
+// Reads stdin a character at a time; getchar() blocks this task only
+static void serverLoop() {
+    char line[64];
+    size_t length = 0;
+    while (true) {
+        int c = std::getchar();
+        if (c == EOF) {
+            pros::delay(20);
+        } else if (c == '\n' || c == '\r') {
+            line[length] = '\0';
+            if (length > 0) handleCommand(line);
+            length = 0;
+        } else if (length < sizeof(line) - 1) {
+            line[length++] = static_cast<char>(c);
+        }
+    }
+}
+
+void startParamServer() {
+    pros::Task::create(serverLoop, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "param_server");
+}
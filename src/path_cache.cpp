@@ -0,0 +1,69 @@
+#include "path_cache.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+static PreparedPath cache[PATH_CACHE_MAX];
+static std::atomic<size_t> cached = 0; // Entries below this are complete
+
+bool parsePath(const asset& path, std::vector<PathPoint>& points) {
+    points.clear();
+    const char* text = reinterpret_cast<const char*>(path.buf);
+    const char* end = text + path.size;
+    while (text < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(text, '\n', end - text));
+        if (lineEnd == nullptr) lineEnd = end;
+        if (lineEnd - text >= 7 && std::strncmp(text, "endData", 7) == 0) break;
+        // Copy the line so strtof can't run past it (assets aren't null terminated)
+        char line[96];
+        size_t length = std::min<size_t>(lineEnd - text, sizeof(line) - 1);
+        std::memcpy(line, text, length);
+        line[length] = '\0';
+        char* cursor = line;
+        PathPoint point;
+        float* fields[3] = {&point.x, &point.y, &point.speed};
+        bool ok = true;
+        for (float* field : fields) {
+            char* next;
+            *field = std::strtof(cursor, &next);
+            if (next == cursor) ok = false;
+            cursor = next;
+            while (*cursor == ',' || *cursor == ' ') cursor++;
+        }
+        if (ok) points.push_back(point);
+        text = lineEnd + 1;
+    }
+    return !points.empty();
+}
+
+const PreparedPath* findPreparedPath(const asset& path) {
+    size_t count = cached.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (cache[i].key == path.buf) return &cache[i];
+    }
+    return nullptr;
+}
+
+const PreparedPath* preparePath(const asset& path) {
+    if (const PreparedPath* found = findPreparedPath(path)) return found;
+    size_t index = cached.load(std::memory_order_relaxed);
+    if (index >= PATH_CACHE_MAX) return nullptr;
+    PreparedPath& entry = cache[index];
+    if (!parsePath(path, entry.points)) return nullptr;
+    entry.key = path.buf;
+    // The path ends at its first stop (speed 0); anything after that only extends the line for the lookahead
+    entry.end = entry.points.size() - 1;
+    for (size_t i = 0; i < entry.points.size(); i++) {
+        if (entry.points[i].speed == 0) {
+            entry.end = i;
+            break;
+        }
+    }
+    entry.length = 0;
+    for (size_t i = 1; i <= entry.end; i++) {
+        entry.length += std::hypot(entry.points[i].x - entry.points[i - 1].x, entry.points[i].y - entry.points[i - 1].y);
+    }
+    cached.store(index + 1, std::memory_order_release);
+    return &entry;
+}
@@ -0,0 +1,113 @@
+#include "profiler.hpp"
+#include "deferred_log.hpp"
+#include "serial_out.hpp"
+#include <atomic>
+#include <cstring>
+
+#define PROFILE_MAX_SLOTS 32
+#define PROFILE_MAX_TASKS 24
+#define PROBE_SPIN_US 1000 // Length of one measuring spin
+#define PROBE_GAP_US 20    // A jump between two micros() reads larger than this means the probe was preempted
+#define PROBE_WINDOW_US 1000000
+
+static ProfileSlot slots[PROFILE_MAX_SLOTS];
+static std::atomic<int> slotCount = 0;
+static pros::Mutex slotMutex;
+
+// Lowest and highest stack addresses seen at checkpoints, per task
+struct StackMark {
+    pros::task_t task = nullptr;
+    uintptr_t high = 0;
+    uintptr_t low = UINTPTR_MAX;
+};
+
+static StackMark stackMarks[PROFILE_MAX_TASKS];
+static std::atomic<float> cpuLoad = 0;
+
+int profilerSlot(const char* name) {
+    std::lock_guard<pros::Mutex> lock(slotMutex);
+    int count = slotCount;
+    for (int i = 0; i < count; i++) {
+        if (std::strcmp(slots[i].name, name) == 0) return i;
+    }
+    if (count == PROFILE_MAX_SLOTS) return -1;
+    slots[count].name = name;
+    slotCount = count + 1;
+    return count;
+}
+
+// Each slot is only ever written by the task that owns the scope, so no lock is needed here
+void profilerRecord(int slot, uint32_t us) {
+    if (slot < 0) return;
+    ProfileSlot& s = slots[slot];
+    s.calls++;
+    s.lastUs = us;
+    if (us > s.maxUs) s.maxUs = us;
+    s.totalUs += us;
+}
+
+void profilerCheckpoint() {
+    pros::task_t self = pros::c::task_get_current();
+    uintptr_t sp = reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+    for (StackMark& mark : stackMarks) {
+        if (mark.task != self && mark.task != nullptr) continue;
+        // Claiming an empty entry races only with other first-time tasks; a lost race just drops one sample
+        if (mark.task == nullptr) mark.task = self;
+        if (sp > mark.high) mark.high = sp;
+        if (sp < mark.low) mark.low = sp;
+        return;
+    }
+}
+
+// Spins at the lowest priority and counts the time it was preempted. Every other task (ours and LemLib's) runs
+// at a higher priority, so preempted time over measured time is the CPU load of the whole program.
+static void probeLoop() {
+    uint64_t measured = 0;
+    uint64_t busy = 0;
+    while (true) {
+        uint64_t start = pros::micros();
+        uint64_t last = start;
+        while (last - start < PROBE_SPIN_US) {
+            uint64_t now = pros::micros();
+            if (now - last > PROBE_GAP_US) busy += now - last;
+            last = now;
+        }
+        measured += last - start;
+        if (measured >= PROBE_WINDOW_US) {
+            cpuLoad = 100.0f * busy / measured;
+            measured = 0;
+            busy = 0;
+        }
+        pros::delay(1); // Let the kernel idle task run (it frees deleted tasks)
+    }
+}
+
+void startProfiler() {
+#if PROFILING_ENABLED
+    pros::Task::create(probeLoop, TASK_PRIORITY_MIN, TASK_STACK_DEPTH_MIN, "cpu_probe");
+#endif
+}
+
+float profilerCpuLoad() { return cpuLoad; }
+
+void printProfile() {
+#if PROFILING_ENABLED
+    uint64_t now = pros::micros();
+    serialOut.print("--- profile @ {} ms: total CPU {:.1f}%, {} tasks ---\n", pros::millis(), profilerCpuLoad(),
+                    pros::Task::get_count());
+    serialOut.print("{:<16} {:>8} {:>8} {:>8} {:>6}\n", "scope", "calls", "avg_us", "max_us", "cpu%");
+    int count = slotCount;
+    for (int i = 0; i < count; i++) {
+        ProfileSlot s = slots[i];
+        uint32_t avg = (s.calls > 0) ? s.totalUs / s.calls : 0;
+        serialOut.print("{:<16} {:>8} {:>8} {:>8} {:>6.2f}\n", s.name, s.calls, avg, s.maxUs, 100.0 * s.totalUs / now);
+    }
+    // Depth between the shallowest and deepest checkpoint; a lower bound on the real high-water mark
+    serialOut.print("{:<16} {:>10}\n", "task", "stack_used");
+    for (const StackMark& mark : stackMarks) {
+        if (mark.task == nullptr) break;
+        serialOut.print("{:<16} {:>10}\n", pros::c::task_get_name(mark.task), mark.high - mark.low);
+    }
+    LOG_INFO("profile: cpu {:.1f}% across {} tasks, {} scopes", profilerCpuLoad(), pros::Task::get_count(), count);
+#endif
+}
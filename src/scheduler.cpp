@@ -0,0 +1,128 @@
+#include "scheduler.hpp"
+#include "profiler.hpp"
+#include "serial_out.hpp"
+#include "watchdog.hpp"
+#include <algorithm>
+#include <cstring>
+
+Scheduler scheduler;
+
+PeriodicJob& Scheduler::addJob(const char* name, uint32_t period, std::function<void()> fn, uint32_t priority,
+                               uint32_t deadline) {
+    return add(name, period, std::move(fn), priority, deadline, true);
+}
+
+PeriodicJob& Scheduler::addBackgroundJob(const char* name, uint32_t period, std::function<void()> fn) {
+    return add(name, period, std::move(fn), 0, 0, false);
+}
+
+PeriodicJob& Scheduler::add(const char* name, uint32_t period, std::function<void()> fn, uint32_t priority,
+                            uint32_t deadline, bool critical) {
+    if (period == 0) period = 1;
+    // Built in place: the stats snapshot can't be moved
+    jobs.emplace_back(new PeriodicJob {
+        .name = name,
+        .period = period,
+        .deadline = (deadline == 0) ? period : deadline,
+        .priority = priority,
+        .autoPriority = (priority == 0),
+        .critical = critical,
+        .fn = std::move(fn),
+    });
+    PeriodicJob& job = *jobs.back();
+    if (started) {
+        if (job.autoPriority) assignPriorities();
+        startJob(job);
+    }
+    return job;
+}
+
+void Scheduler::start() {
+    if (started) return;
+    started = true;
+    assignPriorities();
+    for (auto& job : jobs) startJob(*job);
+}
+
+// Rate-monotonic assignment: the fastest period runs one level below the default priority (the LemLib control and
+// competition tasks) and every slower period steps one level further down, so no job preempts LemLib's control loops.
+void Scheduler::assignPriorities() {
+    std::vector<uint32_t> periods;
+    for (auto& job : jobs) {
+        if (job->autoPriority) periods.push_back(job->period);
+    }
+    std::sort(periods.begin(), periods.end());
+    periods.erase(std::unique(periods.begin(), periods.end()), periods.end());
+    for (auto& job : jobs) {
+        if (!job->autoPriority) continue;
+        int rank = std::lower_bound(periods.begin(), periods.end(), job->period) - periods.begin();
+        job->priority = std::max<int>(TASK_PRIORITY_DEFAULT - 1 - rank, TASK_PRIORITY_MIN + 1);
+        // Tasks that are already running pick up the new level when a faster job is added later
+        if (job->task != nullptr) pros::c::task_set_priority(job->task, job->priority);
+    }
+}
+
+void Scheduler::startJob(PeriodicJob& job) {
+    PeriodicJob* jobPtr = &job;
+    if (job.critical) job.watchdogLoop = watchdogRegister(job.name, job.period);
+    job.task = pros::Task::create([this, jobPtr] { runJob(jobPtr); }, job.priority, TASK_STACK_DEPTH_DEFAULT,
+                                  job.name);
+}
+
+void Scheduler::runJob(PeriodicJob* job) {
+    uint32_t release = pros::millis();
+#if PROFILING_ENABLED
+    int profileSlot = profilerSlot(job->name);
+#endif
+    // Counted here and published after every run, so readers in other tasks never see a half-updated total
+    JobStats stats;
+    while (true) {
+        uint64_t startUs = pros::micros();
+        PROFILE_CHECKPOINT();
+        if (job->critical) watchdogBeat(job->watchdogLoop);
+        job->fn();
+        uint32_t execUs = pros::micros() - startUs;
+#if PROFILING_ENABLED
+        profilerRecord(profileSlot, execUs);
+#endif
+
+        stats.runs++;
+        stats.lastExecUs = execUs;
+        stats.maxExecUs = std::max(stats.maxExecUs, execUs);
+        stats.totalExecUs += execUs;
+        if (pros::millis() - release > job->deadline) stats.deadlineMisses++;
+        job->stats.publish(stats);
+
+        // Background jobs back off while the watchdog reports overloaded control loops
+        uint32_t period = job->critical ? job->period : job->period << degradation;
+        // If the job is more than a whole period late, drop the missed releases instead of running back-to-back
+        uint32_t now = pros::millis();
+        if (now - release >= 2 * period) {
+            stats.skippedReleases += (now - release) / period - 1;
+            job->stats.publish(stats);
+            release = now - period;
+        }
+        pros::Task::delay_until(&release, period);
+    }
+}
+
+JobStats Scheduler::getStats(const char* name) const {
+    for (auto& job : jobs) {
+        if (std::strcmp(job->name, name) == 0) return job->stats.load();
+    }
+    return {};
+}
+
+void Scheduler::printStats() const {
+    serialOut.print("{:<16} {:>6} {:>4} {:>8} {:>6} {:>6} {:>8} {:>8} {:>6}\n", "job", "period", "prio", "runs", "miss",
+                    "skip", "avg_us", "max_us", "cpu%");
+    for (auto& job : jobs) {
+        JobStats stats = job->stats.load();
+        uint32_t avgUs = (stats.runs > 0) ? stats.totalExecUs / stats.runs : 0;
+        // CPU share of this job: average execution time over the period
+        double cpu = 100.0 * avgUs / (job->period * 1000.0);
+        serialOut.print("{:<16} {:>6} {:>4} {:>8} {:>6} {:>6} {:>8} {:>8} {:>6.2f}\n", job->name, job->period,
+                        job->priority, stats.runs, stats.deadlineMisses, stats.skippedReleases, avgUs, stats.maxExecUs,
+                        cpu);
+    }
+}
@@ -0,0 +1,73 @@
+#include "serial_out.hpp"
+#include <cstdio>
+
+SerialOut serialOut;
+
+void SerialOut::start() {
+    pros::Task::create([this] { drainLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "serial_out");
+}
+
+bool SerialOut::write(const void* data, size_t size) {
+    pros::task_t self = pros::c::task_get_current();
+    for (Producer& producer : producers) {
+        pros::task_t owner = producer.task.load(std::memory_order_acquire);
+        if (owner == nullptr) {
+            // Claim a free ring; if another task wins the race, keep looking
+            if (!producer.task.compare_exchange_strong(owner, self)) {
+                if (owner != self) continue;
+            }
+            owner = self;
+        }
+        if (owner == self) return producer.ring.push(data, size);
+    }
+    unclaimedDrops.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+uint32_t SerialOut::dropCount() const {
+    uint32_t drops = unclaimedDrops;
+    for (const Producer& producer : producers) drops += producer.ring.dropCount();
+    return drops;
+}
+
+bool producerGone(pros::task_t task) {
+    pros::task_state_e_t state = pros::c::task_get_state(task);
+    return state == pros::E_TASK_STATE_DELETED || state == pros::E_TASK_STATE_INVALID;
+}
+
+void SerialOut::drainLoop() {
+    // Each ring only ever holds whole records, so emptying a ring in one go never splits a frame or line
+    static uint8_t chunk[SERIAL_RING_SIZE];
+    uint32_t reportedDrops = 0;
+    while (true) {
+        for (Producer& producer : producers) {
+            // Check the owner first: a deleted task pushes nothing more, so this pop empties its ring for good
+            pros::task_t owner = producer.task.load(std::memory_order_acquire);
+            bool gone = owner != nullptr && producerGone(owner);
+            size_t size = producer.ring.pop(chunk, sizeof(chunk));
+            if (size > 0) std::fwrite(chunk, 1, size, stdout);
+            if (gone) producer.task.store(nullptr, std::memory_order_release);
+        }
+        std::fflush(stdout);
+        uint32_t drops = dropCount();
+        if (drops != reportedDrops) {
+            std::printf("serial_out: %lu records dropped\n", (unsigned long)(drops - reportedDrops));
+            reportedDrops = drops;
+        }
+        pros::delay(SERIAL_DRAIN_PERIOD);
+    }
+}
+
+RingSink::RingSink() {
+    setFormat("[{level}] {time}: {message}\n");
+    setLowestLevel(lemlib::Level::INFO);
+}
+
+void RingSink::sendMessage(const lemlib::Message& message) {
+    serialOut.write(message.message.data(), message.message.size());
+}
+
+std::shared_ptr<RingSink> ringSink() {
+    static std::shared_ptr<RingSink> sink = std::make_shared<RingSink>();
+    return sink;
+}
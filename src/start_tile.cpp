@@ -0,0 +1,56 @@
+#include "start_tile.hpp"
+#include <cmath>
+
+static constexpr float DEG_TO_RAD = 3.14159265f / 180;
+
+float wallDistance(float x, float y, float heading, float halfWidth, bool* hitsSide) {
+    float dx = std::sin(heading * DEG_TO_RAD);
+    float dy = std::cos(heading * DEG_TO_RAD);
+    float toSide = INFINITY;
+    float toEnd = INFINITY;
+    if (std::fabs(dx) > 1e-6f) toSide = ((dx > 0 ? halfWidth : -halfWidth) - x) / dx;
+    if (std::fabs(dy) > 1e-6f) toEnd = ((dy > 0 ? halfWidth : -halfWidth) - y) / dy;
+    if (hitsSide != nullptr) *hitsSide = toSide < toEnd;
+    return std::fmin(toSide, toEnd);
+}
+
+StartFit fitStartPose(const StartPose& candidate, const float (&readings)[START_SENSOR_COUNT],
+                      const StartFitSettings& settings) {
+    StartFit fit;
+    fit.pose = candidate;
+    float xSum = 0, ySum = 0;
+    int xCount = 0, yCount = 0;
+    for (int i = 0; i < START_SENSOR_COUNT; i++) {
+        if (readings[i] < 0) continue;
+        const StartSensorMount& mount = settings.mounts[i];
+        float heading = candidate.theta + mount.angle;
+        bool hitsSide;
+        // Measured from the tracking center, like resetOdometry() does
+        float expected = wallDistance(candidate.x, candidate.y, heading, settings.fieldHalfWidth, &hitsSide);
+        float measured = readings[i] + mount.offset;
+        float tolerance = settings.baseTolerance + settings.rangeTolerance * expected;
+        float error = (measured - expected) / tolerance;
+        if (std::fabs(error) > 1) continue; // Something other than the wall, or the wrong tile
+        fit.agreeing++;
+        fit.score += error * error;
+        // The wall is at x (or y) = +/-halfWidth, so the measured distance gives the center's coordinate directly
+        if (hitsSide) {
+            float dx = std::sin(heading * DEG_TO_RAD);
+            xSum += (dx > 0 ? settings.fieldHalfWidth : -settings.fieldHalfWidth) - measured * dx;
+            xCount++;
+        } else {
+            float dy = std::cos(heading * DEG_TO_RAD);
+            ySum += (dy > 0 ? settings.fieldHalfWidth : -settings.fieldHalfWidth) - measured * dy;
+            yCount++;
+        }
+    }
+    fit.matched = fit.agreeing >= settings.minSensors;
+    if (xCount > 0) fit.pose.x = xSum / xCount;
+    if (yCount > 0) fit.pose.y = ySum / yCount;
+    return fit;
+}
+
+StartPose allianceStartPose(const StartPose& red, bool isRed) {
+    if (isRed) return red;
+    return StartPose {-red.x, -red.y, red.theta + 180};
+}
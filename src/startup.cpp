@@ -0,0 +1,152 @@
+#include "startup.hpp"
+#include "auton_registry.hpp"
+#include "path_cache.hpp"
+#include "macro.hpp"
+#include "input_recorder.hpp"
+#include "controller_display.hpp"
+#include "deferred_log.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+static std::atomic<uint32_t> ready = 0;
+static std::atomic<uint32_t> failures = 0;
+
+// Marks a step done. Runs last in the step's task.
+static void finish(StartupStep step, const char* name, bool ok) {
+    if (!ok) failures |= step;
+    uint32_t done = ready.fetch_or(step) | step;
+    LOG_INFO("startup: {} {} at {} ms", name, ok ? "ready" : "FAILED", pros::millis());
+    // A failed step has already put its problem on the controller; leave that up
+    if (done == STARTUP_ALL && failures == 0) controllerDisplay.print(2, "Ready {}ms", pros::millis());
+    deferredLog.releaseTask(); // The task exits next
+}
+
+// --- IMU ---
+// The first step to start and the slowest (about two seconds), so everything else overlaps it
+static void bringUpImu() {
+    bool calibrated = false;
+    for (int attempt = 1; attempt <= IMU_CALIBRATION_ATTEMPTS && !calibrated; attempt++) {
+        if (imu.reset(false) == PROS_ERR) break; // Not plugged in
+        pros::delay(2 * DEVICE_UPDATE_PERIOD);    // Give the sensor a cycle to report that it is calibrating
+        uint32_t start = pros::millis();
+        // Headings read as infinity until calibration has finished
+        while ((imu.is_calibrating() || !std::isfinite(imu.get_heading())) &&
+               pros::millis() - start < IMU_CALIBRATION_TIMEOUT) {
+            pros::delay(10);
+        }
+        calibrated = !imu.is_calibrating() && std::isfinite(imu.get_heading());
+        if (!calibrated) LOG_WARN("startup: IMU calibration attempt {} failed", attempt);
+    }
+    // Start odometry only now, so it never integrates headings from a calibrating IMU
+    chassis.calibrate(false);
+    finish(STARTUP_IMU, "IMU", calibrated);
+}
+
+// --- Devices ---
+struct ExpectedDevice {
+    const char* name;
+    int port; // As configured (negative when reversed)
+    pros::c::v5_device_e_t type;
+};
+
+static const ExpectedDevice DEVICES[] = {
+    {"right motor 1", PORT_RIGHT_MOTOR_1, pros::c::E_DEVICE_MOTOR},
+    {"right motor 2", PORT_RIGHT_MOTOR_2, pros::c::E_DEVICE_MOTOR},
+    {"right motor 3", PORT_RIGHT_MOTOR_3, pros::c::E_DEVICE_MOTOR},
+    {"left motor 1", PORT_LEFT_MOTOR_1, pros::c::E_DEVICE_MOTOR},
+    {"left motor 2", PORT_LEFT_MOTOR_2, pros::c::E_DEVICE_MOTOR},
+    {"left motor 3", PORT_LEFT_MOTOR_3, pros::c::E_DEVICE_MOTOR},
+    {"IMU", PORT_IMU, pros::c::E_DEVICE_IMU},
+    {"horizontal encoder", PORT_HORIZONTAL_ENCODER, pros::c::E_DEVICE_ROTATION},
+    {"vertical encoder", PORT_VERTICAL_ENCODER, pros::c::E_DEVICE_ROTATION},
+    {"right distance", PORT_DISTANCE_RIGHT, pros::c::E_DEVICE_DISTANCE},
+    {"left distance", PORT_DISTANCE_LEFT, pros::c::E_DEVICE_DISTANCE},
+    {"front distance", PORT_DISTANCE_FRONT, pros::c::E_DEVICE_DISTANCE},
+    {"back distance", PORT_DISTANCE_BACK, pros::c::E_DEVICE_DISTANCE},
+};
+
+static bool checkMotorTemperatures(pros::MotorGroup& group, const char* side) {
+    bool ok = true;
+    for (uint8_t i = 0; i < 3; i++) {
+        double temperature = group.get_temperature(i);
+        if (std::isfinite(temperature) && temperature >= MOTOR_HOT_TEMPERATURE) {
+            LOG_WARN("startup: {} motor {} is at {:.0f}C", side, i + 1, temperature);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static void bringUpDevices() {
+    horizontal_encoder.reset_position();
+    vertical_encoder.reset_position();
+
+    bool ok = true;
+    for (const ExpectedDevice& device : DEVICES) {
+        uint8_t port = std::abs(device.port);
+        pros::c::v5_device_e_t found = pros::c::get_plugged_type(port);
+        if (found == device.type) continue;
+        ok = false;
+        if (found == pros::c::E_DEVICE_NONE) {
+            LOG_WARN("startup: {} (port {}) is not plugged in", device.name, port);
+        } else {
+            LOG_WARN("startup: port {} should be the {} but has device type {}", port, device.name,
+                     static_cast<int>(found));
+        }
+        controllerDisplay.print(2, "Check port {}", port);
+    }
+    ok = checkMotorTemperatures(left_motors, "left") && ok;
+    ok = checkMotorTemperatures(right_motors, "right") && ok;
+    scanInputLogs(); // Up to INPUT_LOG_MAX_FILES SD card probes, kept out of disabled()
+    finish(STARTUP_DEVICES, "devices", ok);
+}
+
+// --- Paths ---
+// Parses every auton's paths, not just the selected one, so changing the selection later costs nothing. The saved
+// macro comes along: both are reads the autons need, and nothing touches the macro before this step is ready.
+static void loadPaths() {
+    bool ok = true;
+    for (int i = 0; i < AUTON_COUNT; i++) {
+        for (const asset* path : AUTONS[i].paths) {
+            if (path != nullptr && preparePath(*path) == nullptr) {
+                LOG_WARN("startup: a path of auton {} could not be parsed", AUTONS[i].name);
+                ok = false;
+            }
+        }
+    }
+    // No saved macro is normal (nothing recorded yet)
+    if (pros::usd::is_installed() && loadMacro()) LOG_INFO("startup: macro of {} frames loaded", macroFrameCount());
+    finish(STARTUP_PATHS, "paths", ok);
+}
+
+// --- UI ---
+static void buildUi() {
+    pros::lcd::initialize(); // Initialize the VEX LCD (for basic prints)
+    finish(STARTUP_UI, "UI", true);
+}
+
+void startStartup() {
+    controllerDisplay.print(2, "Starting...");
+    pros::Task::create(bringUpImu, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "startup_imu");
+    pros::Task::create(bringUpDevices, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "startup_devices");
+    pros::Task::create(loadPaths, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "startup_paths");
+    pros::Task::create(buildUi, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "startup_ui");
+}
+
+bool startupReady(uint32_t steps) { return (ready & steps) == steps; }
+
+uint32_t startupFailures() { return failures; }
+
+bool waitForStartup(uint32_t steps, uint32_t timeout) {
+    uint32_t start = pros::millis();
+    while (!startupReady(steps)) {
+        if (pros::millis() - start >= timeout) {
+            LOG_WARN("startup: gave up waiting after {} ms (done {:#x}, wanted {:#x})", timeout,
+                     static_cast<uint32_t>(ready), steps);
+            return false;
+        }
+        pros::delay(STARTUP_POLL_PERIOD);
+    }
+    return true;
+}
@@ -3,4 +3,8 @@
 #include "subsystems.hpp"
 
 
-//Code for subsytems goes here
\ No newline at end of file
+//Code for subsytems goes here
+
+void subsystemControl(uint16_t held, uint16_t pressed) {
+    // Read buttons from `held`/`pressed` rather than the controller so macro playback works
+}
@@ -0,0 +1,59 @@
+#include "telemetry.hpp"
+#include "pros/apix.h"
+#include "device_state.hpp"
+#include "odom_state.hpp"
+#include "serial_out.hpp"
+#include <cmath>
+#include <cstdio>
+
+BinaryTelemetry telemetry;
+
+void BinaryTelemetry::begin() {
+    // PROS normally wraps stdout in its own COBS stream packets; our frames carry their own framing
+    pros::c::serctl(SERCTL_DISABLE_COBS, nullptr);
+}
+
+void BinaryTelemetry::sendRaw(uint8_t channel, const void* payload, size_t size) {
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t length = telemetryEncode(channel, pros::millis(), payload, size, frame);
+    if (length == 0) return;
+    if (!serialOut.write(frame, length)) return;
+    frames++;
+    bytes += length;
+}
+
+// LemLib's PID exposes its gains and state but not the derivative or output of the last update
+PidSample samplePid(PidLoop loop, const lemlib::PID& pid) {
+    return PidSample {
+        .loop = loop,
+        .error = pid.prevError,
+        .integral = pid.integral,
+        .p = pid.kP * pid.prevError,
+        .i = pid.kI * pid.integral,
+        .d = NAN,
+        .output = NAN,
+    };
+}
+
+void telemetryUpdate() {
+    OdomState odom = odomState.load();
+    telemetry.send(TELEMETRY_POSE,
+                   PoseSample {odom.x, odom.y, odom.theta, odom.xVel, odom.yVel, odom.thetaVel});
+
+    DeviceState devices = deviceState.load();
+    DriveSample drive {};
+    for (int i = 0; i < 3; i++) {
+        drive.leftVelocity += devices.left[i].velocity / 3;
+        drive.rightVelocity += devices.right[i].velocity / 3;
+        drive.leftVoltage += devices.left[i].voltage / 3;
+        drive.rightVoltage += devices.right[i].voltage / 3;
+        drive.leftCurrent += devices.left[i].current;
+        drive.rightCurrent += devices.right[i].current;
+    }
+    telemetry.send(TELEMETRY_DRIVE, drive);
+
+    if (chassis.isInMotion()) {
+        telemetry.send(TELEMETRY_PID, samplePid(PID_LATERAL, chassis.lateralPID));
+        telemetry.send(TELEMETRY_PID, samplePid(PID_ANGULAR, chassis.angularPID));
+    }
+}
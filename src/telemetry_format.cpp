@@ -0,0 +1,67 @@
+#include "telemetry_format.hpp"
+#include <cstring>
+
+const TelemetryChannelInfo* telemetryChannelInfo(uint8_t id) {
+    for (const TelemetryChannelInfo& info : TELEMETRY_CHANNELS) {
+        if (info.id == id) return &info;
+    }
+    return nullptr;
+}
+
+uint8_t crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+    return crc;
+}
+
+size_t cobsEncode(const uint8_t* data, size_t length, uint8_t* out) {
+    size_t write = 1;
+    size_t codeIndex = 0;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] != 0) {
+            out[write++] = data[i];
+            code++;
+        }
+        if (data[i] == 0 || code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = write++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    return write;
+}
+
+size_t cobsDecode(const uint8_t* data, size_t length, uint8_t* out) {
+    size_t read = 0;
+    size_t write = 0;
+    while (read < length) {
+        uint8_t code = data[read++];
+        if (code == 0 || read + code - 1 > length) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            if (data[read] == 0) return 0;
+            out[write++] = data[read++];
+        }
+        // A full 0xFF block has no implied zero; neither does the final block
+        if (code != 0xFF && read < length) out[write++] = 0;
+    }
+    return write;
+}
+
+size_t telemetryEncode(uint8_t channel, uint32_t time, const void* payload, size_t size,
+                       uint8_t out[TELEMETRY_MAX_FRAME]) {
+    if (size > TELEMETRY_MAX_PAYLOAD) return 0;
+    uint8_t raw[TELEMETRY_MAX_PAYLOAD + TELEMETRY_OVERHEAD];
+    raw[0] = channel;
+    std::memcpy(raw + 1, &time, sizeof(time));
+    std::memcpy(raw + 5, payload, size);
+    raw[5 + size] = crc8(raw, 5 + size);
+    out[0] = 0; // Leading delimiter separates the frame from any text printed before it
+    size_t length = 1 + cobsEncode(raw, size + TELEMETRY_OVERHEAD, out + 1);
+    out[length++] = 0;
+    return length;
+}
@@ -0,0 +1,54 @@
+#include "params.hpp"
+#include "robot_config.hpp"
+#include "autons.hpp"
+#include "drive_curves.hpp"
+#include "heading_hold.hpp"
+#include <memory>
+
+// LemLib builds its exit conditions from the controller settings once, in the Chassis constructor, and their
+// thresholds are const. Rebuild them in place so changed thresholds take effect; only called at a motion boundary.
+static void rebuildExit(lemlib::ExitCondition& exit, float range, float time) {
+    std::destroy_at(&exit);
+    std::construct_at(&exit, range, static_cast<int>(time));
+}
+
+static void rebuildLateralExits() {
+    rebuildExit(chassis.lateralSmallExit, chassis.lateralSettings.smallError,
+                chassis.lateralSettings.smallErrorTimeout);
+    rebuildExit(chassis.lateralLargeExit, chassis.lateralSettings.largeError,
+                chassis.lateralSettings.largeErrorTimeout);
+}
+
+static void rebuildAngularExits() {
+    rebuildExit(chassis.angularSmallExit, chassis.angularSettings.smallError,
+                chassis.angularSettings.smallErrorTimeout);
+    rebuildExit(chassis.angularLargeExit, chassis.angularSettings.largeError,
+                chassis.angularSettings.largeErrorTimeout);
+}
+
+void registerParams() {
+    const ParamBoundary motion = ParamBoundary::MOTION;
+    // Gains
+    params.add("lat.kp", &chassis.lateralPID.kP, 0, 100, motion);
+    params.add("lat.ki", &chassis.lateralPID.kI, 0, 100, motion);
+    params.add("lat.kd", &chassis.lateralPID.kD, 0, 500, motion);
+    params.add("ang.kp", &chassis.angularPID.kP, 0, 100, motion);
+    params.add("ang.ki", &chassis.angularPID.kI, 0, 100, motion);
+    params.add("ang.kd", &chassis.angularPID.kD, 0, 500, motion);
+    params.add("lat.slew", &chassis.lateralSettings.slew, 0, 127, motion);
+    params.add("ang.slew", &chassis.angularSettings.slew, 0, 127, motion);
+    // Exit thresholds
+    params.add("lat.small_err", &chassis.lateralSettings.smallError, 0, 24, motion, rebuildLateralExits);
+    params.add("lat.small_time", &chassis.lateralSettings.smallErrorTimeout, 0, 5000, motion, rebuildLateralExits);
+    params.add("lat.large_err", &chassis.lateralSettings.largeError, 0, 24, motion, rebuildLateralExits);
+    params.add("lat.large_time", &chassis.lateralSettings.largeErrorTimeout, 0, 5000, motion, rebuildLateralExits);
+    params.add("ang.small_err", &chassis.angularSettings.smallError, 0, 45, motion, rebuildAngularExits);
+    params.add("ang.small_time", &chassis.angularSettings.smallErrorTimeout, 0, 5000, motion, rebuildAngularExits);
+    params.add("ang.large_err", &chassis.angularSettings.largeError, 0, 45, motion, rebuildAngularExits);
+    params.add("ang.large_time", &chassis.angularSettings.largeErrorTimeout, 0, 5000, motion, rebuildAngularExits);
+    // Path following
+    params.add("follow.lookahead", &followLookahead, 1, 48, motion);
+    // Driver control
+    registerDriveCurveParams();
+    registerHeadingHoldParams();
+}
@@ -0,0 +1,147 @@
+#include "watchdog.hpp"
+#include "robot_config.hpp"
+#include "scheduler.hpp"
+#include "deferred_log.hpp"
+#include <atomic>
+
+#define WATCHDOG_MAX_LOOPS 16
+#define WATCHDOG_EVENT_LOG 16 // Overrun events kept for printing, must be a power of two
+
+struct OverrunEvent {
+    int loop;
+    uint32_t time;    // pros::millis() when detected
+    uint32_t cycleUs; // Offending cycle time (or time since the last beat for a stall)
+    bool stall;
+};
+
+// One slot of the event log. `seq` is 2 * index + 1 while event `index` is being written and 2 * index + 2 once it
+// is complete, so the reader can tell a published event from one still being written or already overwritten.
+struct EventSlot {
+    std::atomic<uint32_t> seq = 0;
+    std::atomic<int> loop = 0;
+    std::atomic<uint32_t> time = 0;
+    std::atomic<uint32_t> cycleUs = 0;
+    std::atomic<bool> stall = false;
+};
+
+static LoopHealth loops[WATCHDOG_MAX_LOOPS];
+// Kept out of LoopHealth so the watchdog job never reads one half-written: written by the beating loop, read and
+// cleared by watchdogUpdate(). 32 bits of micros() wrap after 71 minutes, which the interval math doesn't mind.
+static std::atomic<uint32_t> lastBeats[WATCHDOG_MAX_LOOPS];
+static std::atomic<int> loopCount = 0;
+static pros::Mutex registerMutex;
+
+// Written by the loops, read by watchdogUpdate()
+static EventSlot events[WATCHDOG_EVENT_LOG];
+static std::atomic<uint32_t> eventsWritten = 0; // Events claimed by writers; a claimed slot may not be filled yet
+static uint32_t eventsPrinted = 0;
+
+static uint32_t lastOverrunTime = 0;
+static uint32_t lastLevelChange = 0;
+
+static void recordEvent(int loop, uint32_t cycleUs, bool stall) {
+    uint32_t index = eventsWritten.fetch_add(1);
+    EventSlot& slot = events[index % WATCHDOG_EVENT_LOG];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.loop.store(loop, std::memory_order_relaxed);
+    slot.time.store(pros::millis(), std::memory_order_relaxed);
+    slot.cycleUs.store(cycleUs, std::memory_order_relaxed);
+    slot.stall.store(stall, std::memory_order_relaxed);
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+}
+
+enum class EventRead { READY, PENDING, LOST };
+
+// Copies event `index` if it has been published and not overwritten since
+static EventRead readEvent(uint32_t index, OverrunEvent& out) {
+    const EventSlot& slot = events[index % WATCHDOG_EVENT_LOG];
+    uint32_t expected = 2 * index + 2;
+    uint32_t before = slot.seq.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(before - expected) < 0) return EventRead::PENDING;
+    if (before != expected) return EventRead::LOST;
+    out = {slot.loop.load(std::memory_order_relaxed), slot.time.load(std::memory_order_relaxed),
+           slot.cycleUs.load(std::memory_order_relaxed), slot.stall.load(std::memory_order_relaxed)};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.seq.load(std::memory_order_relaxed) == expected ? EventRead::READY : EventRead::LOST;
+}
+
+int watchdogRegister(const char* name, uint32_t period) {
+    std::lock_guard<pros::Mutex> lock(registerMutex);
+    int id = loopCount;
+    if (id == WATCHDOG_MAX_LOOPS) return -1;
+    loops[id].name = name;
+    loops[id].period = period;
+    loopCount = id + 1;
+    return id;
+}
+
+void watchdogBeat(int loop) {
+    if (loop < 0) return;
+    LoopHealth& health = loops[loop];
+    uint32_t now = static_cast<uint32_t>(pros::micros()) | 1; // Never 0, which means disarmed
+    uint32_t last = lastBeats[loop];
+    if (last != 0) {
+        uint32_t cycle = now - last;
+        health.lastCycleUs = cycle;
+        if (cycle > health.worstCycleUs) health.worstCycleUs = cycle;
+        if (cycle > health.period * 1000 * WATCHDOG_OVERRUN_FACTOR) {
+            health.overruns++;
+            recordEvent(loop, cycle, false);
+        }
+    }
+    lastBeats[loop] = now;
+}
+
+void watchdogDisarm(int loop) {
+    if (loop >= 0) lastBeats[loop] = 0;
+}
+
+LoopHealth watchdogHealth(int loop) {
+    if (loop < 0 || loop >= loopCount) return LoopHealth {};
+    LoopHealth health = loops[loop];
+    health.lastBeatUs = lastBeats[loop];
+    return health;
+}
+
+void watchdogUpdate() {
+    uint32_t nowUs = pros::micros();
+    uint32_t now = pros::millis();
+
+    // A loop that has missed WATCHDOG_STALL_CYCLES beats is stalled; record it once and wait for it to come back
+    int count = loopCount;
+    for (int i = 0; i < count; i++) {
+        LoopHealth& health = loops[i];
+        uint32_t lastBeat = lastBeats[i];
+        if (lastBeat == 0 || nowUs - lastBeat < health.period * 1000 * WATCHDOG_STALL_CYCLES) continue;
+        // A beat that lands meanwhile wins; the loop is running again
+        if (!lastBeats[i].compare_exchange_strong(lastBeat, 0)) continue;
+        health.stalls++;
+        recordEvent(i, nowUs - lastBeat, true);
+    }
+
+    // Print everything recorded since the last check (only the newest WATCHDOG_EVENT_LOG survive a burst)
+    uint32_t written = eventsWritten;
+    if (written - eventsPrinted > WATCHDOG_EVENT_LOG) eventsPrinted = written - WATCHDOG_EVENT_LOG;
+    for (; eventsPrinted != written; eventsPrinted++) {
+        OverrunEvent event;
+        EventRead read = readEvent(eventsPrinted, event);
+        if (read == EventRead::PENDING) break; // Claimed but still being written; picked up next time
+        if (read == EventRead::LOST) continue;  // Overwritten by a later burst
+        lastOverrunTime = event.time;
+        LOG_WARN("watchdog: {} {} at {} ms, cycle {} us (period {} ms)", loops[event.loop].name,
+                 event.stall ? "stalled" : "overran", event.time, event.cycleUs, loops[event.loop].period);
+        // Each new overrun pushes background work back one more step
+        if (scheduler.getDegradation() < WATCHDOG_MAX_DEGRADATION && now - lastLevelChange >= WATCHDOG_ESCALATE_TIME) {
+            scheduler.setDegradation(scheduler.getDegradation() + 1);
+            lastLevelChange = now;
+        }
+    }
+
+    // Clean for long enough: restore one level at a time
+    if (scheduler.getDegradation() > 0 && now - lastOverrunTime >= WATCHDOG_RECOVERY_TIME &&
+        now - lastLevelChange >= WATCHDOG_RECOVERY_TIME) {
+        scheduler.setDegradation(scheduler.getDegradation() - 1);
+        lastLevelChange = now;
+    }
+}
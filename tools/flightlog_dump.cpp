@@ -0,0 +1,60 @@
+// Prints a flight recorder run (/usd/run_NNNN.kfr) as CSV, one line per record: time,type,values...
+// Build on a host machine from the repository root:
+//   g++ -std=c++20 -O2 -Iinclude tools/flightlog_dump.cpp src/flight_log.cpp -o flightlog_dump
+#include "flight_log.hpp"
+#include <cstring>
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <run_NNNN.kfr>\n", argv[0]);
+        return 1;
+    }
+    FlightLogReader reader;
+    if (!reader.open(argv[1])) {
+        std::fprintf(stderr, "%s: not a readable flight log (version %d expected)\n", argv[1], FLIGHT_VERSION);
+        return 1;
+    }
+    const FlightHeader& header = reader.header();
+    std::fprintf(stderr, "run %u: auton %d, %s, started at %u ms, %s\n", (unsigned)header.runIndex, header.auton,
+                 header.red ? "RED" : "BLUE", (unsigned)header.startTime,
+                 header.finalized ? "finalized" : "not finalized (recovering complete blocks)");
+
+    std::printf("time,type,values\n");
+    uint8_t type, size;
+    uint32_t time;
+    uint8_t payload[255];
+    uint32_t records = 0;
+    while (reader.next(type, time, payload, size)) {
+        records++;
+        if (type == FLIGHT_POSE && size == sizeof(PoseSample)) {
+            PoseSample s;
+            std::memcpy(&s, payload, sizeof(s));
+            std::printf("%u,pose,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", (unsigned)time, s.x, s.y, s.theta, s.xVel, s.yVel,
+                        s.thetaVel);
+        } else if (type == FLIGHT_MOTORS && size == sizeof(MotorSample)) {
+            MotorSample s;
+            std::memcpy(&s, payload, sizeof(s));
+            std::printf("%u,motors", (unsigned)time);
+            for (float v : s.velocity) std::printf(",%.1f", v);
+            for (int16_t v : s.voltage) std::printf(",%d", v);
+            for (int16_t v : s.current) std::printf(",%d", v);
+            std::printf("\n");
+        } else if (type == FLIGHT_PID && size == sizeof(PidSample)) {
+            PidSample s;
+            std::memcpy(&s, payload, sizeof(s));
+            std::printf("%u,pid,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n", (unsigned)time, (unsigned)s.loop, s.error,
+                        s.integral, s.p, s.i, s.d, s.output);
+        } else if (type == FLIGHT_MOTION && size == sizeof(MotionEvent)) {
+            MotionEvent s;
+            std::memcpy(&s, payload, sizeof(s));
+            std::printf("%u,motion,%u,%u,%s,%u,%.3f,%.3f,%.3f,%d,%.3f\n", (unsigned)time, (unsigned)s.id,
+                        (unsigned)s.kind, s.phase == MOTION_START ? "start" : "end", (unsigned)s.cancelled,
+                        s.targetX, s.targetY, s.targetTheta, (int)s.timeout, s.progress);
+        } else {
+            std::printf("%u,unknown_%u,%u bytes\n", (unsigned)time, (unsigned)type, (unsigned)size);
+        }
+    }
+    std::fprintf(stderr, "%u records in %u blocks (header: %u records, %u dropped)\n", (unsigned)records,
+                 (unsigned)reader.blocksRead(), (unsigned)header.records, (unsigned)header.drops);
+    return 0;
+}
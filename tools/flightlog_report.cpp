@@ -0,0 +1,337 @@
+// Summarizes flight recorder runs (/usd/run_NNNN.kfr) per motion and per run, to find where auton time goes.
+// Build on a host machine from the repository root:
+//   g++ -std=c++20 -O2 -Iinclude tools/flightlog_report.cpp src/flight_log.cpp -o flightlog_report
+// Usage:
+//   flightlog_report [--motions motions.csv] [--runs runs.csv] [--tolerance-in 1] [--tolerance-deg 2]
+//                    [--saturation-mv 11500] run_0001.kfr [run_0002.kfr ...]
+//
+// Per motion:
+//   cross-track  Moves: distance from the straight line between the start position and the target.
+//                Turns and swings: how far the robot drifted from where the turn started.
+//   settle       Time from the start until the error entered the tolerance band for the last time.
+//   exit wait    Time from that point until LemLib ended the motion (its small-error/timeout exit conditions).
+//   saturation   Share of drive motor samples at or above the saturation voltage.
+// Per run, jitter is measured on the odometry timestamps, which are published once per control tick.
+// Follow motions are measured against their path's end point when it was logged, with no cross-track error (the path
+// itself is not in the log).
+#include "flight_log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct Options {
+    const char* motionsPath = nullptr;
+    const char* runsPath = nullptr;
+    float toleranceIn = 1;
+    float toleranceDeg = 2;
+    int saturationMv = 11500;
+    std::vector<const char*> runs;
+};
+
+struct PoseRow {
+    uint32_t time;
+    PoseSample pose;
+};
+
+struct MotorRow {
+    uint32_t time;
+    MotorSample motors;
+};
+
+struct Motion {
+    MotionEvent event; // Start event
+    uint32_t startTime = 0;
+    uint32_t endTime = 0;
+    bool ended = false;
+    bool cancelled = false;
+};
+
+struct Run {
+    std::string path;
+    FlightHeader header;
+    std::vector<PoseRow> poses;
+    std::vector<MotorRow> motors;
+    std::vector<Motion> motions;
+};
+
+struct MotionMetrics {
+    float duration = 0; // ms
+    float finalError = NAN;
+    float maxCrossTrack = NAN;
+    float rmsCrossTrack = NAN;
+    float settle = NAN;   // ms
+    float exitWait = NAN; // ms
+    float saturation = 0; // %
+};
+
+struct RunMetrics {
+    float duration = 0;      // ms between the first and last pose
+    float motionTime = 0;    // ms inside motions
+    float exitWaitTime = 0;  // ms of exit waits across motions
+    float unsettledTime = 0; // ms of motions that never settled (timed out or cancelled)
+    float meanInterval = 0, jitter = 0, maxInterval = 0; // Odometry tick intervals, ms
+    int lateTicks = 0;       // Intervals more than 1.5x the median
+};
+
+static const char* kindName(uint8_t kind) {
+    switch (kind) {
+        case MOTION_TURN_TO_POINT: return "turnToPoint";
+        case MOTION_TURN_TO_HEADING: return "turnToHeading";
+        case MOTION_SWING_TO_HEADING: return "swingToHeading";
+        case MOTION_SWING_TO_POINT: return "swingToPoint";
+        case MOTION_MOVE_TO_POSE: return "moveToPose";
+        case MOTION_MOVE_TO_POINT: return "moveToPoint";
+        case MOTION_FOLLOW: return "follow";
+        default: return "unknown";
+    }
+}
+
+static bool isLinear(uint8_t kind) { return kind == MOTION_MOVE_TO_POSE || kind == MOTION_MOVE_TO_POINT; }
+
+static bool isTurn(uint8_t kind) {
+    return kind == MOTION_TURN_TO_POINT || kind == MOTION_TURN_TO_HEADING || kind == MOTION_SWING_TO_HEADING ||
+           kind == MOTION_SWING_TO_POINT;
+}
+
+// Angle difference in (-180, 180]
+static float wrapDegrees(float angle) {
+    angle = std::fmod(angle + 180, 360);
+    if (angle < 0) angle += 360;
+    return angle - 180;
+}
+
+// Distance (inches) or heading error (degrees) from the motion's target; LemLib headings are clockwise from +y
+static float targetError(const MotionEvent& event, const PoseSample& pose) {
+    // Follow motions carry their end point when the path was prepared before the auton
+    if (isLinear(event.kind) || event.kind == MOTION_FOLLOW) {
+        return std::hypot(event.targetX - pose.x, event.targetY - pose.y); // NaN when the end point is unknown
+    }
+    if (event.kind == MOTION_TURN_TO_HEADING || event.kind == MOTION_SWING_TO_HEADING) {
+        return std::fabs(wrapDegrees(event.targetTheta - pose.theta));
+    }
+    if (event.kind == MOTION_TURN_TO_POINT || event.kind == MOTION_SWING_TO_POINT) {
+        float heading = std::atan2(event.targetX - pose.x, event.targetY - pose.y) * 180 / M_PI;
+        return std::fabs(wrapDegrees(heading - pose.theta));
+    }
+    return NAN;
+}
+
+static float crossTrack(const MotionEvent& event, const PoseSample& start, const PoseSample& pose) {
+    if (isTurn(event.kind)) return std::hypot(pose.x - start.x, pose.y - start.y);
+    if (!isLinear(event.kind)) return NAN;
+    float dx = event.targetX - start.x, dy = event.targetY - start.y;
+    float length = std::hypot(dx, dy);
+    if (length < 1e-3f) return std::hypot(pose.x - start.x, pose.y - start.y);
+    return std::fabs(dx * (pose.y - start.y) - dy * (pose.x - start.x)) / length;
+}
+
+static bool loadRun(const char* path, Run& run) {
+    FlightLogReader reader;
+    if (!reader.open(path)) return false;
+    run.path = path;
+    run.header = reader.header();
+    uint8_t type, size;
+    uint32_t time;
+    uint8_t payload[255];
+    while (reader.next(type, time, payload, size)) {
+        if (type == FLIGHT_POSE && size == sizeof(PoseSample)) {
+            PoseRow row {time, {}};
+            std::memcpy(&row.pose, payload, size);
+            // The recorder samples faster than odometry can change; keep one row per odometry tick
+            if (run.poses.empty() || run.poses.back().time != time) run.poses.push_back(row);
+        } else if (type == FLIGHT_MOTORS && size == sizeof(MotorSample)) {
+            MotorRow row {time, {}};
+            std::memcpy(&row.motors, payload, size);
+            if (run.motors.empty() || run.motors.back().time != time) run.motors.push_back(row);
+        } else if (type == FLIGHT_MOTION && size == sizeof(MotionEvent)) {
+            MotionEvent event;
+            std::memcpy(&event, payload, size);
+            if (event.phase == MOTION_START) {
+                run.motions.push_back(Motion {event, time});
+            } else {
+                for (Motion& motion : run.motions) {
+                    if (motion.event.id != event.id) continue;
+                    motion.endTime = time;
+                    motion.ended = true;
+                    motion.cancelled = event.cancelled;
+                }
+            }
+        }
+    }
+    // A motion still running when the run ended (or the file was cut off) ends at the last sample
+    uint32_t last = run.poses.empty() ? 0 : run.poses.back().time;
+    for (Motion& motion : run.motions) {
+        if (!motion.ended) motion.endTime = std::max(last, motion.startTime);
+    }
+    return true;
+}
+
+static MotionMetrics measureMotion(const Run& run, const Motion& motion, const Options& options) {
+    MotionMetrics metrics;
+    metrics.duration = motion.endTime - motion.startTime;
+    float tolerance = isTurn(motion.event.kind) ? options.toleranceDeg : options.toleranceIn;
+
+    const PoseSample* start = nullptr;
+    float sumSquares = 0;
+    int samples = 0;
+    bool inBand = false;
+    uint32_t entered = 0;
+    for (const PoseRow& row : run.poses) {
+        if (row.time < motion.startTime || row.time > motion.endTime) continue;
+        if (start == nullptr) start = &row.pose;
+        float track = crossTrack(motion.event, *start, row.pose);
+        if (!std::isnan(track)) {
+            metrics.maxCrossTrack = std::isnan(metrics.maxCrossTrack) ? track : std::max(metrics.maxCrossTrack, track);
+            sumSquares += track * track;
+            samples++;
+        }
+        float error = targetError(motion.event, row.pose);
+        metrics.finalError = error;
+        bool within = error <= tolerance;
+        if (within && !inBand) entered = row.time;
+        inBand = within;
+    }
+    if (samples > 0) metrics.rmsCrossTrack = std::sqrt(sumSquares / samples);
+    if (inBand) {
+        metrics.settle = entered - motion.startTime;
+        metrics.exitWait = motion.endTime - entered;
+    }
+
+    int saturated = 0, total = 0;
+    for (const MotorRow& row : run.motors) {
+        if (row.time < motion.startTime || row.time > motion.endTime) continue;
+        for (int16_t voltage : row.motors.voltage) saturated += std::abs(voltage) >= options.saturationMv;
+        total += 6;
+    }
+    if (total > 0) metrics.saturation = 100.0f * saturated / total;
+    return metrics;
+}
+
+static RunMetrics measureRun(const Run& run, const std::vector<MotionMetrics>& motions) {
+    RunMetrics metrics;
+    if (run.poses.size() >= 2) {
+        metrics.duration = run.poses.back().time - run.poses.front().time;
+        std::vector<float> intervals;
+        for (size_t i = 1; i < run.poses.size(); i++) {
+            intervals.push_back(run.poses[i].time - run.poses[i - 1].time);
+        }
+        float sum = 0, sumSquares = 0;
+        for (float interval : intervals) {
+            sum += interval;
+            sumSquares += interval * interval;
+            metrics.maxInterval = std::max(metrics.maxInterval, interval);
+        }
+        metrics.meanInterval = sum / intervals.size();
+        metrics.jitter = std::sqrt(std::max(0.0f, sumSquares / intervals.size() -
+                                                      metrics.meanInterval * metrics.meanInterval));
+        std::vector<float> sorted = intervals;
+        std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+        float median = sorted[sorted.size() / 2];
+        for (float interval : intervals) metrics.lateTicks += interval > 1.5f * median;
+    }
+    for (const MotionMetrics& motion : motions) {
+        metrics.motionTime += motion.duration;
+        if (std::isnan(motion.exitWait)) {
+            metrics.unsettledTime += motion.duration;
+        } else {
+            metrics.exitWaitTime += motion.exitWait;
+        }
+    }
+    return metrics;
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--motions") && hasValue) {
+            options.motionsPath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--runs") && hasValue) {
+            options.runsPath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--tolerance-in") && hasValue) {
+            options.toleranceIn = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--tolerance-deg") && hasValue) {
+            options.toleranceDeg = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--saturation-mv") && hasValue) {
+            options.saturationMv = std::atoi(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            return false;
+        } else {
+            options.runs.push_back(argv[i]);
+        }
+    }
+    return !options.runs.empty();
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "usage: %s [--motions motions.csv] [--runs runs.csv] [--tolerance-in 1] [--tolerance-deg 2]\n"
+                     "       [--saturation-mv 11500] run_NNNN.kfr...\n",
+                     argv[0]);
+        return 1;
+    }
+    std::FILE* motionsCsv = options.motionsPath ? std::fopen(options.motionsPath, "w") : nullptr;
+    std::FILE* runsCsv = options.runsPath ? std::fopen(options.runsPath, "w") : nullptr;
+    if (motionsCsv) {
+        std::fprintf(motionsCsv, "run,auton,id,kind,start_ms,duration_ms,cancelled,target_x,target_y,target_theta,"
+                                 "final_error,max_cross_track,rms_cross_track,settle_ms,exit_wait_ms,saturation_pct\n");
+    }
+    if (runsCsv) {
+        std::fprintf(runsCsv, "run,auton,side,finalized,duration_ms,motions,motion_ms,exit_wait_ms,unsettled_ms,"
+                              "idle_ms,tick_mean_ms,tick_jitter_ms,tick_max_ms,late_ticks,dropped_records\n");
+    }
+
+    int failures = 0;
+    for (const char* path : options.runs) {
+        Run run;
+        if (!loadRun(path, run)) {
+            std::fprintf(stderr, "%s: not a readable flight log\n", path);
+            failures++;
+            continue;
+        }
+        std::vector<MotionMetrics> motions;
+        for (const Motion& motion : run.motions) motions.push_back(measureMotion(run, motion, options));
+        RunMetrics metrics = measureRun(run, motions);
+        const FlightHeader& header = run.header;
+        float idle = std::max(0.0f, metrics.duration - metrics.motionTime);
+
+        std::printf("\nrun %u  %s  auton %d %s%s\n", (unsigned)header.runIndex, run.path.c_str(), header.auton,
+                    header.red ? "RED" : "BLUE", header.finalized ? "" : "  (not finalized)");
+        std::printf("  %-4s %-15s %8s %8s %8s %8s %8s %8s %6s\n", "id", "motion", "time", "settle", "exit", "error",
+                    "xtrack", "xt_rms", "sat%");
+        for (size_t i = 0; i < run.motions.size(); i++) {
+            const Motion& motion = run.motions[i];
+            const MotionMetrics& m = motions[i];
+            std::printf("  %-4u %-15s %8.0f %8.0f %8.0f %8.2f %8.2f %8.2f %6.1f%s\n", (unsigned)motion.event.id,
+                        kindName(motion.event.kind), m.duration, m.settle, m.exitWait, m.finalError, m.maxCrossTrack,
+                        m.rmsCrossTrack, m.saturation, motion.cancelled ? "  cancelled" : "");
+            if (motionsCsv) {
+                std::fprintf(motionsCsv, "%u,%d,%u,%s,%u,%.0f,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.0f,%.0f,%.1f\n",
+                             (unsigned)header.runIndex, header.auton, (unsigned)motion.event.id,
+                             kindName(motion.event.kind), (unsigned)(motion.startTime - header.startTime),
+                             m.duration, motion.cancelled, motion.event.targetX, motion.event.targetY,
+                             motion.event.targetTheta, m.finalError, m.maxCrossTrack, m.rmsCrossTrack, m.settle,
+                             m.exitWait, m.saturation);
+            }
+        }
+        std::printf("  %.0f ms total: %.0f in motions (%.0f exit waits, %.0f never settled), %.0f between motions\n",
+                    metrics.duration, metrics.motionTime, metrics.exitWaitTime, metrics.unsettledTime, idle);
+        std::printf("  odometry ticks: %.2f ms mean, %.2f ms jitter, %.0f ms max, %d late; %u records dropped\n",
+                    metrics.meanInterval, metrics.jitter, metrics.maxInterval, metrics.lateTicks,
+                    (unsigned)header.drops);
+        if (runsCsv) {
+            std::fprintf(runsCsv, "%u,%d,%s,%d,%.0f,%zu,%.0f,%.0f,%.0f,%.0f,%.2f,%.2f,%.0f,%d,%u\n",
+                         (unsigned)header.runIndex, header.auton, header.red ? "red" : "blue", header.finalized,
+                         metrics.duration, run.motions.size(), metrics.motionTime, metrics.exitWaitTime,
+                         metrics.unsettledTime, idle, metrics.meanInterval, metrics.jitter, metrics.maxInterval,
+                         metrics.lateTicks, (unsigned)header.drops);
+        }
+    }
+    if (motionsCsv) std::fclose(motionsCsv);
+    if (runsCsv) std::fclose(runsCsv);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,31 @@
+// Prints an input log recorded on the robot (/usd/inputs_NNN.bin) as CSV.
+// Build on a host machine from the repository root:
+//   g++ -std=c++20 -O2 -Iinclude tools/inputlog_dump.cpp src/input_log.cpp -o inputlog_dump
+#include "input_log.hpp"
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <inputs_NNN.bin>\n", argv[0]);
+        return 1;
+    }
+    InputLogHeader header;
+    std::vector<InputRecord> records;
+    if (!readInputLog(argv[1], header, records)) {
+        std::fprintf(stderr, "%s: not a readable input log (version %d expected)\n", argv[1], INPUT_LOG_VERSION);
+        return 1;
+    }
+    std::fprintf(stderr, "auton %d, %s, %u records every %u ms\n", header.auton, header.red ? "RED" : "BLUE",
+                 (unsigned)header.count, (unsigned)header.period);
+    std::printf("time,horizontal,vertical,l1,l2,l3,r1,r2,r3,imu_rotation,imu_heading,gyro_z,"
+                "dist_right,dist_left,dist_front,dist_back,left_x,left_y,right_x,right_y,buttons\n");
+    for (const InputRecord& r : records) {
+        std::printf("%u,%d,%d,%d,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%d,%d,%d,%d,%d,%d,%d,%d,%u\n", (unsigned)r.time,
+                    (int)r.horizontalPosition, (int)r.verticalPosition, (int)r.leftMotorPosition[0],
+                    (int)r.leftMotorPosition[1], (int)r.leftMotorPosition[2], (int)r.rightMotorPosition[0],
+                    (int)r.rightMotorPosition[1], (int)r.rightMotorPosition[2], r.imuRotation, r.imuHeading,
+                    r.imuGyroZ, r.distance[0], r.distance[1], r.distance[2], r.distance[3], r.sticks[0], r.sticks[1],
+                    r.sticks[2], r.sticks[3], (unsigned)r.buttons);
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+// Reads and changes live parameters on the robot (see include/params.hpp) over its serial port.
+// Build on a Linux or macOS host from the repository root:
+//   g++ -std=c++20 -O2 -Iinclude tools/param_cli.cpp src/telemetry_format.cpp -o param_cli
+// Usage:
+//   param_cli /dev/ttyACM1 list
+//   param_cli /dev/ttyACM1 get lat.kp
+//   param_cli /dev/ttyACM1 set lat.kp 8 lat.kd 12    (staged together, then committed as one batch)
+//   param_cli /dev/ttyACM1 shell                     (type raw protocol commands, e.g. "S lat.kp 8", "C")
+// The port can be any tty, so a pseudo-terminal can stand in for the robot.
+// By default the robot's output is expected in PROS's COBS stream framing; pass --raw when the robot has disabled it
+// (TELEMETRY_ENABLED). Robot output that is not a reply is ignored.
+#include "telemetry_format.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+static int port = -1;
+static bool raw = false;
+static std::vector<uint8_t> frame; // Bytes of the PROS packet being received
+static std::string text;           // Decoded robot output not yet split into lines
+
+static bool openPort(const char* path) {
+    port = open(path, O_RDWR | O_NOCTTY);
+    if (port < 0) return false;
+    termios settings;
+    if (tcgetattr(port, &settings) == 0) {
+        cfmakeraw(&settings);
+        cfsetspeed(&settings, B115200);
+        tcsetattr(port, TCSANOW, &settings);
+    }
+    return true;
+}
+
+static bool send(const std::string& command) {
+    std::string line = command + "\n";
+    return write(port, line.data(), line.size()) == static_cast<ssize_t>(line.size());
+}
+
+// Adds received bytes to `text`, unwrapping PROS packets: COBS([stream id:4]["sout" data]) followed by 0x00
+static void receive(const uint8_t* data, size_t length) {
+    if (raw) {
+        text.append(reinterpret_cast<const char*>(data), length);
+        return;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] != 0) {
+            frame.push_back(data[i]);
+            continue;
+        }
+        std::vector<uint8_t> decoded(frame.size());
+        size_t size = frame.empty() ? 0 : cobsDecode(frame.data(), frame.size(), decoded.data());
+        if (size > 4 && std::memcmp(decoded.data(), "sout", 4) == 0) {
+            text.append(reinterpret_cast<const char*>(decoded.data()) + 4, size - 4);
+        }
+        frame.clear();
+    }
+}
+
+// Waits up to `timeout` ms for the next reply line (starting with '$'); false on timeout
+static bool readReply(std::string& reply, int timeout = 1000) {
+    while (true) {
+        size_t end;
+        while ((end = text.find('\n')) != std::string::npos) {
+            std::string line = text.substr(0, end);
+            text.erase(0, end + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty() && line[0] == '$') {
+                reply = line;
+                return true;
+            }
+        }
+        pollfd fd {port, POLLIN, 0};
+        if (poll(&fd, 1, timeout) <= 0) return false;
+        uint8_t buffer[512];
+        ssize_t count = read(port, buffer, sizeof(buffer));
+        if (count <= 0) return false;
+        receive(buffer, count);
+    }
+}
+
+// Sends a command and prints its reply; false if it failed or timed out
+static bool request(const std::string& command, std::string& reply) {
+    if (!send(command) || !readReply(reply)) {
+        std::fprintf(stderr, "no reply to \"%s\"\n", command.c_str());
+        return false;
+    }
+    if (reply.rfind("$ERR", 0) == 0) {
+        std::fprintf(stderr, "%s: %s\n", command.c_str(), reply.c_str() + 5);
+        return false;
+    }
+    return true;
+}
+
+static int list() {
+    if (!send("L")) return 1;
+    std::string reply;
+    std::printf("%-4s %-20s %12s %12s %12s\n", "id", "name", "value", "min", "max");
+    while (readReply(reply)) {
+        if (reply == "$E") return 0;
+        int id;
+        char name[64];
+        float value, min, max;
+        if (std::sscanf(reply.c_str(), "$P %d %63s %f %f %f", &id, name, &value, &min, &max) == 5) {
+            std::printf("%-4d %-20s %12g %12g %12g\n", id, name, value, min, max);
+        }
+    }
+    std::fprintf(stderr, "list cut off\n");
+    return 1;
+}
+
+static int shell() {
+    char line[128];
+    std::string reply;
+    while (std::fgets(line, sizeof(line), stdin) != nullptr) {
+        line[std::strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') continue;
+        if (!send(line)) return 1;
+        // A list replies with several lines; everything else with one
+        bool listing = line[0] == 'L';
+        while (readReply(reply)) {
+            std::printf("%s\n", reply.c_str());
+            if (!listing || reply == "$E") break;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int arg = 1;
+    if (arg < argc && std::strcmp(argv[arg], "--raw") == 0) {
+        raw = true;
+        arg++;
+    }
+    if (argc - arg < 2) {
+        std::fprintf(stderr, "usage: %s [--raw] <tty> list | get <name> | set <name> <value>... | shell\n", argv[0]);
+        return 1;
+    }
+    if (!openPort(argv[arg])) {
+        std::perror(argv[arg]);
+        return 1;
+    }
+    std::string command = argv[arg + 1];
+    std::string reply;
+    if (command == "list") return list();
+    if (command == "shell") return shell();
+    if (command == "get" && argc - arg == 3) {
+        if (!request(std::string("G ") + argv[arg + 2], reply)) return 1;
+        std::printf("%s %s\n", argv[arg + 2], std::strchr(reply.c_str() + 3, ' ') + 1);
+        return 0;
+    }
+    if (command == "set" && argc - arg >= 4 && (argc - arg) % 2 == 0) {
+        // Stage everything first so the robot applies the whole set at one loop boundary
+        for (int i = arg + 2; i < argc; i += 2) {
+            if (!request(std::string("S ") + argv[i] + " " + argv[i + 1], reply)) return 1;
+        }
+        if (!request("C", reply)) return 1;
+        std::printf("committed %s parameter(s)\n", reply.c_str() + 3);
+        return 0;
+    }
+    std::fprintf(stderr, "unknown command %s\n", command.c_str());
+    return 1;
+}
@@ -0,0 +1,90 @@
+// Decodes binary telemetry frames (see include/telemetry_format.hpp) from a serial port or a capture file and prints
+// one CSV line per record. Anything that is not a valid frame (printf output from the robot) goes to stderr.
+// Build on a host machine from the repository root:
+//   g++ -std=c++20 -O2 -Iinclude tools/telemetry_decode.cpp src/telemetry_format.cpp -o telemetry_decode
+// Usage:
+//   telemetry_decode /dev/ttyACM1 > run.csv     (serial port, already in raw mode: stty -F /dev/ttyACM1 raw)
+//   telemetry_decode capture.bin > run.csv
+//   telemetry_decode < capture.bin
+#include "telemetry_format.hpp"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static bool headerPrinted[256];
+
+static void printRecord(const uint8_t* raw, size_t length) {
+    const TelemetryChannelInfo* info = telemetryChannelInfo(raw[0]);
+    uint32_t time;
+    std::memcpy(&time, raw + 1, sizeof(time));
+    if (!headerPrinted[info->id]) {
+        std::printf("# %s,time,%s\n", info->name, info->fields);
+        headerPrinted[info->id] = true;
+    }
+    std::printf("%s,%u", info->name, (unsigned)time);
+    const uint8_t* field = raw + 5;
+    for (const char* type = info->types; *type != '\0'; type++, field += 4) {
+        if (*type == 'f') {
+            float value;
+            std::memcpy(&value, field, 4);
+            std::printf(",%g", value);
+        } else if (*type == 'i') {
+            int32_t value;
+            std::memcpy(&value, field, 4);
+            std::printf(",%d", (int)value);
+        } else {
+            uint32_t value;
+            std::memcpy(&value, field, 4);
+            std::printf(",%u", (unsigned)value);
+        }
+    }
+    std::printf("\n");
+}
+
+// Returns true if `chunk` (bytes between two delimiters) was a valid frame
+static bool handleChunk(const std::vector<uint8_t>& chunk) {
+    if (chunk.empty() || chunk.size() > TELEMETRY_MAX_FRAME) return false;
+    uint8_t raw[TELEMETRY_MAX_FRAME];
+    size_t length = cobsDecode(chunk.data(), chunk.size(), raw);
+    if (length < TELEMETRY_OVERHEAD || crc8(raw, length - 1) != raw[length - 1]) return false;
+    const TelemetryChannelInfo* info = telemetryChannelInfo(raw[0]);
+    if (info == nullptr || info->size != length - TELEMETRY_OVERHEAD) return false;
+    printRecord(raw, length);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::FILE* in = stdin;
+    if (argc == 2) {
+        in = std::fopen(argv[1], "rb");
+        if (in == nullptr) {
+            std::perror(argv[1]);
+            return 1;
+        }
+    } else if (argc > 2) {
+        std::fprintf(stderr, "usage: %s [serial port or capture file]\n", argv[0]);
+        return 1;
+    }
+    unsigned long frames = 0;
+    unsigned long bad = 0;
+    std::vector<uint8_t> chunk;
+    int c;
+    while ((c = std::fgetc(in)) != EOF) {
+        if (c != 0) {
+            chunk.push_back(c);
+            continue;
+        }
+        if (handleChunk(chunk)) {
+            frames++;
+        } else if (!chunk.empty()) {
+            // Not a frame: robot text output (or a frame damaged in transit)
+            std::fwrite(chunk.data(), 1, chunk.size(), stderr);
+            bad++;
+        }
+        chunk.clear();
+        std::fflush(stdout);
+    }
+    if (!chunk.empty()) std::fwrite(chunk.data(), 1, chunk.size(), stderr);
+    std::fprintf(stderr, "\n%lu frames decoded, %lu non-frame chunks\n", frames, bad);
+    return 0;
+}